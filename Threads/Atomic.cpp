@@ -1,11 +1,24 @@
 #include "Atomic.hpp"
+#include "AtomicWide.h"
+#include "Counter.h"
+#include "Epoch.h"
+#include "SeqLock.h"
+#include "Spinlock.h"
+#include "Timer.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <iostream>
+#include <mutex>
+#include <shared_mutex>
 #include <thread>
 #include <vector>
 
+#if defined(_MSC_VER) || defined(_MSC_FULL_VER) || defined(_WIN32) || defined(_WIN64)
+    #include <tbb/queuing_mutex.h>
+#endif
+
 
 /*
  Сайты: https://vk.com/@habr-kak-rabotat-s-atomarnymi-tipami-dannyh-v-c?ysclid=lyfjpgv4gn827137332
@@ -14,172 +27,137 @@
         https://stackoverflow.com/questions/50298358/where-is-the-lock-for-a-stdatomic
  */
 
-namespace atomic
+// Несовпадения результата бенчмарка с ожидаемым: проверка не зависит от NDEBUG, итог печатается в конце ATOMIC::Start
+static std::atomic<int> benchmarkMismatches = 0;
+
+template <typename T>
+void CheckResult(const char* name, const T& value, const T& expected)
+{
+    if (value == expected)
+        return;
+    
+    ++benchmarkMismatches;
+    std::cout << "Несовпадение " << name << ": " << value << ", ожидается " << expected << std::endl;
+}
+
+template <class TSpinlock>
+void PrintSymbol(char c, TSpinlock& spinlock)
 {
-    // compare_exchange_weak
-    namespace compare_exchange_strong
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    spinlock.Lock();
+    for (int i = 0; i < 10; ++i)
     {
-        class Spinlock
-        {
-            Spinlock(const Spinlock&) = delete;
-            
-        public:
-            Spinlock() = default;
-            ~Spinlock() = default;
-            
-            void Lock() noexcept
-            {
-                while(_flag);
-                bool expected = false;
-                // LOAD (no) ↑ STORE (no)
-                _flag.compare_exchange_strong(expected, true);
-                // LOAD (no) ↓ STORE (no)
-            }
-            
-            bool Try_lock() noexcept
-            {
-                bool expected = false;
-                // LOAD (no) ↑ STORE (no)
-                return _flag.compare_exchange_strong(expected, true);
-                // LOAD (no) ↓ STORE (no)
-            }
-            
-            void Unlock() noexcept
-            {
-                // LOAD (no) ↑ STORE (no)
-                _flag = false;
-                // LOAD (no) ↓ STORE (no)
-            }
-            
-        private:
-            std::atomic<bool> _flag = ATOMIC_FLAG_INIT; // false
-        };
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::cout << c;
     }
+    spinlock.Unlock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+}
+
+/*
+ Конкуренция за spinlock: threads потоков по count раз захватывают блокировку и увеличивают общий счетчик.
+ Возвращает время в мс.
+ */
+template <class TSpinlock>
+double Contention(TSpinlock& spinlock, int threads, int count)
+{
+    Timer timer;
+    int counter = 0;
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
     
-    // compare_exchange_strong
-    namespace compare_exchange_weak
+    timer.start();
+    for (int i = 0; i < threads; ++i)
     {
-        class Spinlock
-        {
-        public:
-            void Lock()
+        workers.emplace_back([&]()
             {
-                bool expected = false;
-                // LOAD (no) ↑ STORE (no)
-                while (!_flag.compare_exchange_weak(expected, true, std::memory_order_acquire)) // может быть ложное срабатывания
-                // LOAD (no) ↓ STORE (yes)
-                    expected = false;
-            }
-            
-            void Try_lock()
-            {
-                bool expected = false;
-                // LOAD (no) ↑ STORE (no)
-                _flag.compare_exchange_weak(expected, true, std::memory_order_acquire);
-                // LOAD (no) ↓ STORE (yes)
-            }
-         
-            void Unlock()
-            {
-                // LOAD (yes) ↑ STORE (no)
-                _flag.store(false, std::memory_order_release);
-                // LOAD (no) ↓ STORE (no)
-            }
-         
-        private:
-            std::atomic<bool> _flag;
-        };
+                for (int j = 0; j < count; ++j)
+                {
+                    spinlock.Lock();
+                    ++counter;
+                    spinlock.Unlock();
+                }
+            });
     }
-
-    namespace wait
+    for (auto& worker : workers)
     {
-        class Spinlock
-        {
-            Spinlock(const Spinlock&) = delete;
-            
-        public:
-            Spinlock() = default;
-            ~Spinlock() = default;
-            
-            void Lock() noexcept
-            {
-                // LOAD (no) ↑ STORE (no)
-                if (_flag.test_and_set(std::memory_order_acquire)) // read
-                // LOAD (no) ↓ STORE (yes)
-                    _flag.wait(true);
-            }
-            
-            bool Try_lock() noexcept
-            {
-                // LOAD (no) ↑ STORE (no)
-                return !_flag.test_and_set(std::memory_order_acquire);
-                // LOAD (no) ↓ STORE (yes)
-            }
-            
-            void Unlock() noexcept
-            {
-                // LOAD (yes) ↑ STORE (no)
-                _flag.clear(std::memory_order_release); // write
-                // LOAD (no) ↓ STORE (no)
-                _flag.notify_one();
-            }
-            
-        private:
-            std::atomic_flag _flag = ATOMIC_FLAG_INIT; // false
-        };
+        worker.join();
     }
+    timer.stop();
+    
+    CheckResult("Contention: counter", counter, threads * count);
+    return timer.elapsedMilliseconds();
 }
 
-namespace atomic_flag
+/*
+ Масштабируемость блокировки: то же, что Contention, но захват через RAII объект TScopedLock(lock), например, MCS::Spinlock::Guard, tbb::queuing_mutex::scoped_lock.
+ Возвращает кол-во захватов в секунду.
+ */
+template <class TScopedLock, class TLock>
+double Scaling(TLock& lock, int threads, int count)
 {
-    class Spinlock
+    Timer timer;
+    int counter = 0;
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    
+    timer.start();
+    for (int i = 0; i < threads; ++i)
     {
-        Spinlock(const Spinlock&) = delete;
-        
-    public:
-        Spinlock() = default;
-        ~Spinlock() = default;
-        
-        void Lock() noexcept
-        {
-            // LOAD (no) ↑ STORE (no)
-            if (_flag.test_and_set(std::memory_order_acquire)) // read
-            // LOAD (no) ↓ STORE (yes)
-                _flag.wait(true);
-        }
-        
-        bool Try_lock() noexcept
-        {
-            // LOAD (no) ↑ STORE (no)
-            return !_flag.test_and_set(std::memory_order_acquire);
-            // LOAD (no) ↓ STORE (yes)
-        }
-        
-        void Unlock() noexcept
-        {
-            // LOAD (yes) ↑ STORE (no)
-            _flag.clear(std::memory_order_release); // write
-            // LOAD (no) ↓ STORE (no)
-            _flag.notify_one();
-        }
-        
-    private:
-        std::atomic_flag _flag = ATOMIC_FLAG_INIT; // false
-    };
+        workers.emplace_back([&]()
+            {
+                for (int j = 0; j < count; ++j)
+                {
+                    TScopedLock scopedLock(lock);
+                    ++counter;
+                }
+            });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    timer.stop();
+    
+    CheckResult("Scaling: counter", counter, threads * count);
+    return threads * count / std::max(timer.elapsedSeconds(), 0.001);
 }
 
+/*
+ Справедливость spinlock: threads потоков захватывают блокировку в течении duration.
+ Возвращает отношение min/max кол-ва захватов одного потока: 1 - все потоки получили блокировку поровну, ~0 - некоторые потоки голодают.
+ */
 template <class TSpinlock>
-void PrintSymbol(char c, TSpinlock& spinlock)
+double Fairness(TSpinlock& spinlock, int threads, std::chrono::milliseconds duration)
 {
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    spinlock.Lock();
-    for (int i = 0; i < 10; ++i)
+    std::atomic<bool> stop = false;
+    std::vector<size_t> counts(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    
+    for (int i = 0; i < threads; ++i)
     {
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        std::cout << c;
+        workers.emplace_back([&, i]()
+            {
+                size_t count = 0;
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    spinlock.Lock();
+                    ++count;
+                    spinlock.Unlock();
+                }
+                counts[i] = count;
+            });
     }
-    spinlock.Unlock();
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::this_thread::sleep_for(duration);
+    stop = true;
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    
+    const auto [min, max] = std::minmax_element(counts.begin(), counts.end());
+    return double(*min) / std::max<size_t>(*max, 1);
 }
 
 /*
@@ -280,6 +258,54 @@ namespace ATOMIC
                 lock xadd  DWORD PTR _ZL2v2[rip], eax
             */
         }
+        /*
+         False sharing (ложное разделение): lock xadd эксклюзивно владеет кэш-линией, поэтому при инкременте из многих ядер кэш-линия перебрасывается между ядрами, даже если потоки меняют РАЗНЫЕ переменные в одной кэш-линии.
+         1. общий std::atomic<int> - все потоки пишут в одну переменную.
+         2. массив std::atomic<int> - у каждого потока своя переменная, но соседние переменные в одной кэш-линии (false sharing).
+         3. массив Padded<std::atomic<int>> - у каждого потока своя кэш-линия.
+         4. ShardedCounter - то же, что 3, но номер ячейки выбирается автоматически, сумма - при чтении.
+         */
+        {
+            std::cout << "False sharing" << std::endl;
+            
+            const int threads = std::max(std::thread::hardware_concurrency(), 1u);
+            constexpr int count = 1000000;
+            auto Increment = [&](auto&& increment)
+            {
+                Timer timer;
+                std::vector<std::thread> workers;
+                workers.reserve(threads);
+                
+                timer.start();
+                for (int i = 0; i < threads; ++i)
+                {
+                    workers.emplace_back([&, i]()
+                        {
+                            for (int j = 0; j < count; ++j)
+                                increment(i);
+                        });
+                }
+                for (auto& worker : workers)
+                {
+                    worker.join();
+                }
+                timer.stop();
+                return timer.elapsedMilliseconds();
+            };
+            
+            std::atomic<int> shared = 0;
+            std::vector<std::atomic<int>> adjacent(threads);
+            std::vector<Padded<std::atomic<int>>> padded(threads);
+            ShardedCounter<int> counter;
+            std::cout << "std::atomic<int>: " << Increment([&](int) { shared.fetch_add(1, std::memory_order_relaxed); }) << " мс" << std::endl;
+            std::cout << "std::atomic<int>[]: " << Increment([&](int i) { adjacent[i].fetch_add(1, std::memory_order_relaxed); }) << " мс" << std::endl;
+            std::cout << "Padded<std::atomic<int>>[]: " << Increment([&](int i) { padded[i]->fetch_add(1, std::memory_order_relaxed); }) << " мс" << std::endl;
+            std::cout << "ShardedCounter: " << Increment([&](int) { ++counter; }) << " мс" << std::endl;
+            CheckResult("std::atomic<int>", shared.load(), threads * count);
+            CheckResult("ShardedCounter::Sum", counter.Sum(), threads * count);
+            
+            std::cout << std::endl;
+        }
         // is_lock_free - проверяет возможность применения atomic к типу и возвращает значение: true - можно использовать atomic к данному типу / false - нет, лучше использовать mutex (например, нетривиальный тип и больше > 8 байт - размер регистра)
         {
             class A { int x, y; }; //
@@ -324,6 +350,212 @@ namespace ATOMIC
                       << "std::atomic<I> is lock free? "
                       << std::atomic<I>{}.is_lock_free() << std::endl; // false, 9 > 8
         }
+        /*
+         SeqLock - для часто читаемых структур, которые не lock-free в std::atomic: читатели ничего не записывают и повторяют чтение, если попали на запись.
+         1 писатель постоянно обновляет котировку, читатели читают ее: std::atomic<Quote> (скрытая блокировка) vs std::shared_mutex vs SeqLock<Quote>.
+         */
+        {
+            std::cout << "SeqLock" << std::endl;
+            
+            struct Quote
+            {
+                double bid = 0;
+                double ask = 0;
+                int64_t time = 0;
+            };
+            
+            const int readers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+            constexpr int count = 1000000;
+            std::atomic<int64_t> tornReads = 0; // разорванные чтения, проверка не зависит от NDEBUG
+            auto Benchmark = [&](auto&& store, auto&& load)
+            {
+                Timer timer;
+                std::atomic<bool> stop = false;
+                std::vector<std::thread> threads;
+                threads.reserve(readers + 1);
+                
+                timer.start();
+                threads.emplace_back([&]()
+                    {
+                        for (int64_t time = 1; !stop.load(std::memory_order_relaxed); ++time)
+                            store(Quote{ double(time), double(time + 1), time });
+                    });
+                std::vector<std::thread> readerThreads;
+                for (int i = 0; i < readers; ++i)
+                {
+                    readerThreads.emplace_back([&]()
+                        {
+                            int64_t torn = 0;
+                            for (int j = 0; j < count; ++j)
+                            {
+                                const Quote quote = load();
+                                if (quote.ask != quote.bid + 1 || quote.time != (int64_t)quote.bid)
+                                    ++torn;
+                            }
+                            tornReads += torn;
+                        });
+                }
+                for (auto& thread : readerThreads)
+                {
+                    thread.join();
+                }
+                stop = true;
+                threads.front().join();
+                timer.stop();
+                return readers * count / std::max(timer.elapsedSeconds(), 0.001);
+            };
+            
+            std::atomic<Quote> atomicQuote{ Quote{ 0, 1, 0 } };
+            std::cout << "std::atomic<Quote> is lock free? " << std::boolalpha << atomicQuote.is_lock_free() << std::endl;
+            std::cout << "std::atomic<Quote>: " << Benchmark([&](const Quote& quote) { atomicQuote.store(quote); },
+                                                             [&]() { return atomicQuote.load(); }) << " чтений/сек" << std::endl;
+            
+            std::shared_mutex mutex;
+            Quote sharedQuote{ 0, 1, 0 };
+            std::cout << "std::shared_mutex: " << Benchmark([&](const Quote& quote) { std::unique_lock lock(mutex); sharedQuote = quote; },
+                                                            [&]() { std::shared_lock lock(mutex); return sharedQuote; }) << " чтений/сек" << std::endl;
+            
+            SeqLock<Quote> seqLock(Quote{ 0, 1, 0 });
+            std::cout << "SeqLock<Quote>: " << Benchmark([&](const Quote& quote) { seqLock.Store(quote); },
+                                                         [&]() { return seqLock.Load(); }) << " чтений/сек" << std::endl;
+            std::cout << "разорванных чтений: " << tornReads << " (ожидается 0)" << std::endl;
+            
+            std::cout << std::endl;
+        }
+        /*
+         AtomicWide - атомарная переменная для 16 байтных типов (указатель + метка, два 64-битных счетчика): lock cmpxchg16b/casp, если процессор и компилятор поддерживают, иначе striped lock.
+         Потоки одновременно увеличивают два счетчика через сравнение с обменом: std::atomic<Counters> vs AtomicWide<Counters>.
+         */
+        {
+            std::cout << "AtomicWide" << std::endl;
+            
+            struct Counters
+            {
+                uint64_t requests = 0;
+                uint64_t bytes = 0;
+            };
+            
+            std::cout << "std::atomic<Counters> is lock free? " << std::boolalpha << std::atomic<Counters>{}.is_lock_free() << std::endl;
+            std::cout << "AtomicWide<Counters> is lock free? " << AtomicWide<Counters>::IS_LOCK_FREE
+                      << (AtomicWide<Counters>::STRATEGY == AtomicWideStrategy::DOUBLE_WIDTH_CAS ? " (double-width CAS)" : " (striped lock)") << std::endl;
+            
+            const int threads = std::max(std::thread::hardware_concurrency(), 1u);
+            constexpr int count = 100000;
+            auto Benchmark = [&](auto& counters)
+            {
+                Timer timer;
+                std::vector<std::thread> workers;
+                workers.reserve(threads);
+                
+                timer.start();
+                for (int i = 0; i < threads; ++i)
+                {
+                    workers.emplace_back([&]()
+                        {
+                            for (int j = 0; j < count; ++j)
+                            {
+                                Counters expected = counters.load();
+                                while (!counters.compare_exchange_weak(expected, Counters{ expected.requests + 1, expected.bytes + 64 }));
+                            }
+                        });
+                }
+                for (auto& worker : workers)
+                {
+                    worker.join();
+                }
+                timer.stop();
+                CheckResult("Counters::requests", counters.load().requests, uint64_t(threads) * count);
+                return timer.elapsedMilliseconds();
+            };
+            
+            // Адаптер к интерфейсу std::atomic для общего замера
+            struct Wide
+            {
+                AtomicWide<Counters> value;
+                Counters load() const noexcept { return value.Load(); }
+                bool compare_exchange_weak(Counters& expected, const Counters& desired) noexcept { return value.CompareExchange(expected, desired); }
+            };
+            
+            std::atomic<Counters> atomicCounters;
+            Wide wideCounters;
+            std::cout << "std::atomic<Counters>: " << Benchmark(atomicCounters) << " мс" << std::endl;
+            std::cout << "AtomicWide<Counters>: " << Benchmark(wideCounters) << " мс" << std::endl;
+            
+            std::cout << std::endl;
+        }
+        /*
+         EBR (epoch-based reclamation) - отложенное освобождение памяти для lock-free структур.
+         Писатели заменяют общий указатель на новый объект и откладывают старый (Retire), читатели внутри EpochGuard читают объект: объект не может быть освобожден, пока читатель внутри EpochGuard.
+         */
+        {
+            std::cout << "EBR" << std::endl;
+            
+            static std::atomic<int64_t> live = 0; // кол-во неосвобожденных объектов
+            struct Object
+            {
+                explicit Object(int64_t value) noexcept : value(value), check(~value) { ++live; }
+                ~Object() { value = check = 0; --live; }
+                
+                int64_t value;
+                int64_t check; // ~value: у освобожденного объекта не совпадет
+            };
+            
+            const int threads = std::max(std::thread::hardware_concurrency(), 2u);
+            const int writers = threads / 2, readers = threads - writers;
+            constexpr int count = 200000;
+            
+            std::atomic<Object*> shared = new Object(0);
+            std::atomic<bool> stop = false;
+            std::atomic<int64_t> reads = 0;
+            std::atomic<int64_t> freedReads = 0; // чтения освобожденного объекта, проверка не зависит от NDEBUG
+            std::vector<std::thread> readerThreads, writerThreads;
+            Timer timer;
+            
+            timer.start();
+            for (int i = 0; i < readers; ++i)
+            {
+                readerThreads.emplace_back([&]()
+                    {
+                        int64_t local = 0, freed = 0;
+                        while (!stop.load(std::memory_order_relaxed))
+                        {
+                            EBR::EpochGuard guard;
+                            const Object* object = shared.load(std::memory_order_acquire);
+                            if (object->check != ~object->value) // объект освобожден
+                                ++freed;
+                            ++local;
+                        }
+                        reads += local;
+                        freedReads += freed;
+                    });
+            }
+            for (int i = 0; i < writers; ++i)
+            {
+                writerThreads.emplace_back([&, i]()
+                    {
+                        for (int j = 1; j <= count; ++j)
+                            EBR::Retire(shared.exchange(new Object(int64_t(i) * count + j), std::memory_order_acq_rel));
+                    });
+            }
+            for (auto& thread : writerThreads)
+            {
+                thread.join();
+            }
+            timer.stop();
+            stop = true;
+            for (auto& thread : readerThreads)
+            {
+                thread.join();
+            }
+            
+            delete shared.load();
+            EBR::Synchronize(); // освобождение оставшихся отложенных объектов
+            std::cout << "Retire: " << writers * count / std::max(timer.elapsedSeconds(), 0.001) << " объектов/сек, чтений: " << reads
+                      << ", эпоха: " << EBR::Domain::Instance().Epoch() << std::endl;
+            std::cout << "чтений освобожденного объекта: " << freedReads << " (ожидается 0), не освобождено: " << live << " (ожидается 0)" << std::endl;
+            
+            std::cout << std::endl;
+        }
         // exchange - замена значения
         {
             std::atomic<bool> flag = false;
@@ -352,7 +584,7 @@ namespace ATOMIC
             {
                 std::cout << "Spinlock + compare_exchange_strong" << std::endl;
                 
-                atomic::compare_exchange_strong::Spinlock spinlock;
+                EXAMPLE::atomic::compare_exchange_strong::Spinlock spinlock;
                 std::thread thread1([&] {PrintSymbol('+', spinlock);});
                 std::thread thread2([&] {PrintSymbol('-', spinlock);});
                 
@@ -365,13 +597,121 @@ namespace ATOMIC
             {
                 std::cout << "Spinlock + compare_exchange_weak" << std::endl;
                 
-                atomic::compare_exchange_weak::Spinlock spinlock;
+                EXAMPLE::atomic::compare_exchange_weak::Spinlock spinlock;
                 std::thread thread1([&] {PrintSymbol('+', spinlock);});
                 std::thread thread2([&] {PrintSymbol('-', spinlock);});
                 
                 thread1.join();
                 thread2.join();
                 
+                std::cout << std::endl;
+            }
+            // TTAS Spinlock: ожидание на чтении + pause + экспоненциальная задержка
+            {
+                std::cout << "TTAS Spinlock" << std::endl;
+                
+                TTAS::Spinlock spinlock;
+                std::thread thread1([&] {PrintSymbol('+', spinlock);});
+                std::thread thread2([&] {PrintSymbol('-', spinlock);});
+                
+                thread1.join();
+                thread2.join();
+                
+                std::cout << std::endl;
+                
+                // Lockable
+                {
+                    std::lock_guard lock(spinlock);
+                }
+                
+                // 32 потока
+                {
+                    constexpr int threads = 32, count = 100000;
+                    EXAMPLE::atomic::compare_exchange_strong::Spinlock strongSpinlock;
+                    EXAMPLE::atomic::compare_exchange_weak::Spinlock weakSpinlock;
+                    std::cout << "compare_exchange_strong: " << Contention(strongSpinlock, threads, count) << " мс" << std::endl;
+                    std::cout << "compare_exchange_weak: " << Contention(weakSpinlock, threads, count) << " мс" << std::endl;
+                    std::cout << "TTAS: " << Contention(spinlock, threads, count) << " мс" << std::endl;
+                }
+                
+                std::cout << std::endl;
+            }
+            // Ticket Spinlock: FIFO, ожидание пропорционально месту в очереди
+            {
+                std::cout << "Ticket Spinlock" << std::endl;
+                
+                TICKET::Spinlock spinlock;
+                std::thread thread1([&] {PrintSymbol('+', spinlock);});
+                std::thread thread2([&] {PrintSymbol('-', spinlock);});
+                
+                thread1.join();
+                thread2.join();
+                
+                std::cout << std::endl;
+                
+                // Справедливость: min/max кол-ва захватов одним потоком
+                {
+                    const int threads = std::max(2u, std::thread::hardware_concurrency());
+                    constexpr auto duration = std::chrono::milliseconds(200);
+                    TTAS::Spinlock ttasSpinlock;
+                    EXAMPLE::atomic_flag::Spinlock flagSpinlock;
+                    std::cout << "atomic_flag: " << Fairness(flagSpinlock, threads, duration) << std::endl;
+                    std::cout << "TTAS: " << Fairness(ttasSpinlock, threads, duration) << std::endl;
+                    std::cout << "Ticket: " << Fairness(spinlock, threads, duration) << std::endl;
+                }
+                
+                std::cout << std::endl;
+            }
+            // MCS Spinlock: каждый поток ждет на своем узле
+            {
+                std::cout << "MCS Spinlock" << std::endl;
+                
+                MCS::Spinlock spinlock;
+                {
+                    MCS::Spinlock::Guard guard(spinlock);
+                }
+                
+                // Масштабируемость от 1 потока до всех аппаратных потоков
+                for (int threads = 1; threads <= (int)std::max(std::thread::hardware_concurrency(), 1u); threads *= 2)
+                {
+                    constexpr int count = 1000000;
+                    TTAS::Spinlock ttasSpinlock;
+                    std::cout << "threads = " << threads
+                              << ", TTAS: " << Scaling<std::lock_guard<TTAS::Spinlock>>(ttasSpinlock, threads, count / threads) << " захватов/сек"
+                              << ", MCS: " << Scaling<MCS::Spinlock::Guard>(spinlock, threads, count / threads) << " захватов/сек";
+#if defined(_MSC_VER) || defined(_MSC_FULL_VER) || defined(_WIN32) || defined(_WIN64)
+                    tbb::queuing_mutex queuingMutex;
+                    std::cout << ", tbb::queuing_mutex: " << Scaling<tbb::queuing_mutex::scoped_lock>(queuingMutex, threads, count / threads) << " захватов/сек";
+#endif
+                    std::cout << std::endl;
+                }
+                
+                std::cout << std::endl;
+            }
+            // Адаптивный Spinlock: ожидание в цикле (бюджет по времени владения), затем сон на атомарном слове
+            {
+                std::cout << "Adaptive Spinlock" << std::endl;
+                
+                ADAPTIVE::Spinlock spinlock;
+                std::thread thread1([&] {PrintSymbol('+', spinlock);});
+                std::thread thread2([&] {PrintSymbol('-', spinlock);});
+                
+                thread1.join();
+                thread2.join();
+                
+                std::cout << std::endl;
+                
+                // Потоков в 2 раза больше, чем ядер: владелец может быть вытеснен, spinlock без сна жжет процессор
+                {
+                    constexpr int count = 1000000;
+                    const int threads = 2 * std::max(std::thread::hardware_concurrency(), 1u);
+                    TTAS::Spinlock ttasSpinlock;
+                    std::mutex mutex;
+                    std::cout << "TTAS: " << Scaling<std::lock_guard<TTAS::Spinlock>>(ttasSpinlock, threads, count / threads) << " захватов/сек" << std::endl;
+                    std::cout << "std::mutex: " << Scaling<std::lock_guard<std::mutex>>(mutex, threads, count / threads) << " захватов/сек" << std::endl;
+                    std::cout << "Adaptive: " << Scaling<std::lock_guard<ADAPTIVE::Spinlock>>(spinlock, threads, count / threads) << " захватов/сек, бюджет = " << spinlock.SpinBudget() << " pause" << std::endl;
+                }
+                
                 std::cout << std::endl;
             }
         }
@@ -386,7 +726,7 @@ namespace ATOMIC
         {
             std::cout << "wait + notify_one" << std::endl;
             
-            atomic::wait::Spinlock spinlock;
+            EXAMPLE::atomic::wait::Spinlock spinlock;
             std::thread thread1([&] {PrintSymbol('+', spinlock);});
             std::thread thread2([&] {PrintSymbol('-', spinlock);});
             
@@ -673,6 +1013,8 @@ namespace ATOMIC
                 }
             }
         }
+        
+        std::cout << "Несовпадений в проверках бенчмарков: " << benchmarkMismatches << " (ожидается 0)" << std::endl;
     }
 }
 
@@ -707,7 +1049,7 @@ namespace ATOMIС_FLAG
             [[maybe_unused]] auto test4 = flag.test(); // false
         }
         
-        atomic_flag::Spinlock spinlock;
+        EXAMPLE::atomic_flag::Spinlock spinlock;
         std::thread thread1([&] {PrintSymbol('+', spinlock);});
         std::thread thread2([&] {PrintSymbol('-', spinlock);});
         
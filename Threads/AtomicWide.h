@@ -0,0 +1,171 @@
+#ifndef AtomicWide_h
+#define AtomicWide_h
+
+#include "Spinlock.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(_M_ARM64)
+    #include <intrin.h>
+#endif
+
+
+/*
+ Способ реализации AtomicWide<T>, выбирается во время компиляции:
+ - DOUBLE_WIDTH_CAS - сравнение с обменом двойной ширины (16 байт): x86-64 - lock cmpxchg16b, ARM64 - ldxp/stxp или casp. Lock-free.
+   В GCC/Clang доступно, если компилятор сообщает __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16 (x86-64 - флаг -mcx16, ARM64 - всегда), в MSVC - _InterlockedCompareExchange128.
+ - STRIPED_LOCK - полосатая блокировка (striped lock): глобальный массив spinlock, spinlock выбирается по адресу объекта, поэтому разные объекты редко конкурируют за один spinlock. Не lock-free.
+ Оба способа реализуют одну операцию wide::CompareExchange, через которую выражены Load/Store/Exchange.
+ Замечание: std::atomic<T> для 16 байтных T в GCC/Clang обычно не lock-free (is_lock_free() == false) даже при наличии cmpxchg16b: вызов идет через libatomic, т.к. атомарное чтение через cmpxchg16b требует записи и не работает с памятью только для чтения.
+ */
+enum class AtomicWideStrategy
+{
+    DOUBLE_WIDTH_CAS,
+    STRIPED_LOCK
+};
+
+#if defined(_M_X64) || defined(_M_ARM64) || defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+    inline constexpr bool HAS_DOUBLE_WIDTH_CAS = true;
+#else
+    inline constexpr bool HAS_DOUBLE_WIDTH_CAS = false;
+#endif
+
+// Выбранный способ для типа T (constexpr trait)
+template <typename T>
+inline constexpr AtomicWideStrategy ATOMIC_WIDE_STRATEGY = HAS_DOUBLE_WIDTH_CAS ? AtomicWideStrategy::DOUBLE_WIDTH_CAS : AtomicWideStrategy::STRIPED_LOCK;
+
+namespace wide
+{
+    // 16 байтное слово, с которым работает сравнение с обменом двойной ширины
+#if defined(_M_X64) || defined(_M_ARM64)
+    struct alignas(16) Word
+    {
+        long long value[2]; // [0] - младшие 8 байт, [1] - старшие 8 байт
+    };
+    
+    inline bool CompareExchange(Word& target, Word& expected, const Word& desired) noexcept
+    {
+        return _InterlockedCompareExchange128(target.value, desired.value[1], desired.value[0], expected.value) != 0;
+    }
+#elif defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+    using Word = unsigned __int128;
+    
+    inline bool CompareExchange(Word& target, Word& expected, const Word& desired) noexcept
+    {
+        const Word previous = __sync_val_compare_and_swap(&target, expected, desired); // полный барьер памяти (seq_cst)
+        if (previous == expected)
+            return true;
+        
+        expected = previous;
+        return false;
+    }
+#else
+    struct alignas(16) Word
+    {
+        unsigned char bytes[16];
+    };
+#endif
+    
+    // Spinlock для объекта по адресу
+    inline TTAS::Spinlock& StripeLock(const void* address) noexcept
+    {
+        static TTAS::Spinlock locks[64]; // каждый spinlock в своей кэш-линии
+        return locks[(reinterpret_cast<uintptr_t>(address) >> 4) % std::size(locks)];
+    }
+    
+#if !(defined(_M_X64) || defined(_M_ARM64) || defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16))
+    // STRIPED_LOCK: сравнение с обменом под spinlock
+    inline bool CompareExchange(Word& target, Word& expected, const Word& desired) noexcept
+    {
+        std::lock_guard lock(StripeLock(&target));
+        if (std::memcmp(&target, &expected, sizeof(Word)) == 0)
+        {
+            target = desired;
+            return true;
+        }
+        
+        expected = target;
+        return false;
+    }
+#endif
+}
+
+/*
+ Атомарная переменная для тривиально копируемых типов до 16 байт: указатель + метка (tagged pointer, защита от ABA), два 64-битных счетчика и т.д.
+ Сравнение побайтовое (как в std::atomic), поэтому байты выравнивания (padding) внутри T должны быть одинаковыми, например, обнулены.
+ */
+template <typename T>
+class AtomicWide
+{
+    static_assert(std::is_trivially_copyable_v<T>, "AtomicWide<T>: T должен быть тривиально копируемым");
+    static_assert(sizeof(T) <= 16, "AtomicWide<T>: T должен быть не больше 16 байт");
+    
+    AtomicWide(const AtomicWide&) = delete;
+    AtomicWide& operator=(const AtomicWide&) = delete;
+    
+public:
+    static constexpr AtomicWideStrategy STRATEGY = ATOMIC_WIDE_STRATEGY<T>;
+    static constexpr bool IS_LOCK_FREE = STRATEGY == AtomicWideStrategy::DOUBLE_WIDTH_CAS;
+    
+public:
+    AtomicWide() noexcept : AtomicWide(T{}) {}
+    explicit AtomicWide(const T& value) noexcept : _word(ToWord(value)) {}
+    ~AtomicWide() = default;
+    
+    T Load() const noexcept
+    {
+        // Чтение через сравнение с обменом: если значение совпало с expected, то записывается то же самое значение, иначе expected получает текущее значение
+        wide::Word expected{};
+        wide::CompareExchange(_word, expected, expected);
+        return FromWord(expected);
+    }
+    
+    void Store(const T& value) noexcept
+    {
+        Exchange(value);
+    }
+    
+    T Exchange(const T& value) noexcept
+    {
+        const wide::Word desired = ToWord(value);
+        wide::Word expected{}; // первое сравнение с обменом вернет текущее значение
+        while (!wide::CompareExchange(_word, expected, desired));
+        return FromWord(expected);
+    }
+    
+    // Если текущее значение == expected, то записывается desired и возвращается true, иначе expected получает текущее значение и возвращается false
+    bool CompareExchange(T& expected, const T& desired) noexcept
+    {
+        wide::Word expectedWord = ToWord(expected);
+        if (wide::CompareExchange(_word, expectedWord, ToWord(desired)))
+            return true;
+        
+        expected = FromWord(expectedWord);
+        return false;
+    }
+    
+private:
+    static wide::Word ToWord(const T& value) noexcept
+    {
+        wide::Word word{}; // байты после sizeof(T) - нули
+        std::memcpy(&word, &value, sizeof(T));
+        return word;
+    }
+    
+    // Через байты и std::bit_cast: T не обязан иметь конструктор по умолчанию
+    static T FromWord(const wide::Word& word) noexcept
+    {
+        std::array<unsigned char, sizeof(T)> bytes;
+        std::memcpy(bytes.data(), &word, sizeof(T));
+        return std::bit_cast<T>(bytes);
+    }
+    
+private:
+    alignas(16) mutable wide::Word _word; // mutable: Load через сравнение с обменом записывает
+};
+
+#endif /* AtomicWide_h */
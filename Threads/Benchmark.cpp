@@ -0,0 +1,245 @@
+#include "Benchmark.hpp"
+#include "SharedMutex.h"
+#include "Spinlock.h"
+#include "shared_recursive_mutex.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) || defined(_MSC_FULL_VER) || defined(_WIN32) || defined(_WIN64)
+    #include <tbb/queuing_mutex.h>
+    #include <tbb/spin_mutex.h>
+    #include <tbb/spin_rw_mutex.h>
+#endif
+
+
+/*
+ Замеры блокировок (microbenchmark): для каждой блокировки и каждой конфигурации threads потоков по ITERATIONS раз выполняют:
+ 1. захват блокировки - время от начала захвата до входа в критическую секцию (задержка захвата, acquisition latency).
+ 2. критическая секция - criticalSection pause + изменение общего счетчика.
+ 3. освобождение блокировки.
+ 4. работа вне блокировки (think time) - thinkTime pause.
+ Параметры (перебираются все сочетания):
+ - кол-во потоков: 1, 2, 4, ... до кол-ва аппаратных потоков.
+ - длина критической секции и время вне блокировки в pause (см. CpuPause).
+ Результат: пропускная способность (захватов в секунду) и перцентили задержки захвата p50/p99/p99.9 в нс.
+ Замечание: замер времени (steady_clock::now) добавляет к задержке ~20-50 нс, одинаково для всех блокировок.
+ */
+
+namespace
+{
+    constexpr int ITERATIONS = 20000;
+    constexpr int CRITICAL_SECTIONS[] = { 0, 50, 500 };
+    constexpr int THINK_TIMES[] = { 0, 500 };
+
+    struct Config
+    {
+        int threads;
+        int criticalSection;
+        int thinkTime;
+    };
+
+    struct Result
+    {
+        std::string lock;
+        Config config;
+        double throughput; // захватов в секунду
+        uint64_t p50;      // нс
+        uint64_t p99;      // нс
+        uint64_t p999;     // нс
+    };
+
+    // Захват/освобождение в стиле репозитория: Lock/Unlock
+    template <class TSpinlock>
+    class SpinlockGuard
+    {
+    public:
+        explicit SpinlockGuard(TSpinlock& spinlock) noexcept : _spinlock(spinlock) { _spinlock.Lock(); }
+        ~SpinlockGuard() noexcept { _spinlock.Unlock(); }
+
+    private:
+        TSpinlock& _spinlock;
+    };
+
+#if defined(_MSC_VER) || defined(_MSC_FULL_VER) || defined(_WIN32) || defined(_WIN64)
+    // tbb::spin_rw_mutex::scoped_lock по-умолчанию захватывает на запись
+    class SpinRWReadLock : public tbb::spin_rw_mutex::scoped_lock
+    {
+    public:
+        explicit SpinRWReadLock(tbb::spin_rw_mutex& mutex) : tbb::spin_rw_mutex::scoped_lock(mutex, false) {}
+    };
+#endif
+
+    void Work(int count) noexcept
+    {
+        for (int i = 0; i < count; ++i)
+            CpuPause();
+    }
+
+    // Перцентиль: p - доля от 0 до 1, latencies отсортированы
+    uint64_t Percentile(const std::vector<uint64_t>& latencies, double p) noexcept
+    {
+        if (latencies.empty())
+            return 0;
+
+        return latencies[std::min(latencies.size() - 1, size_t(p * latencies.size()))];
+    }
+
+    /*
+     Замер одной блокировки в одной конфигурации.
+     TScopedLock - RAII захват блокировки TLock (std::lock_guard, std::shared_lock, MCS::Spinlock::Guard, ...).
+     exclusive - монопольный захват: критическая секция меняет общий счетчик, при захвате на чтение (shared) - нет.
+     */
+    template <class TLock, class TScopedLock>
+    Result Run(const std::string& name, const Config& config, bool exclusive = true)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        TLock lock;
+        uint64_t counter = 0;
+        std::atomic<int> ready = 0;
+        std::vector<std::vector<uint64_t>> latencies(config.threads);
+        std::vector<std::thread> threads;
+        threads.reserve(config.threads);
+
+        for (int i = 0; i < config.threads; ++i)
+        {
+            latencies[i].reserve(ITERATIONS); // память выделяется до замера
+            threads.emplace_back([&, i]()
+                {
+                    // Одновременный старт всех потоков
+                    ready.fetch_add(1);
+                    while (ready.load() < config.threads)
+                        std::this_thread::yield();
+
+                    for (int j = 0; j < ITERATIONS; ++j)
+                    {
+                        const auto start = Clock::now();
+                        {
+                            TScopedLock scopedLock(lock);
+                            latencies[i].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+                            Work(config.criticalSection);
+                            if (exclusive)
+                                ++counter;
+                        }
+                        Work(config.thinkTime);
+                    }
+                });
+        }
+
+        const auto start = Clock::now();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::vector<uint64_t> all;
+        all.reserve(size_t(config.threads) * ITERATIONS);
+        for (const auto& thread : latencies)
+            all.insert(all.end(), thread.begin(), thread.end());
+        std::sort(all.begin(), all.end());
+
+        assert(!exclusive || counter == all.size());
+        return { name, config, all.size() / std::max(seconds, 1e-9), Percentile(all, 0.5), Percentile(all, 0.99), Percentile(all, 0.999) };
+    }
+
+    void WriteCsv(const std::string& path, const std::vector<Result>& results)
+    {
+        std::ofstream file(path);
+        file << "lock,threads,critical_section,think_time,throughput,p50_ns,p99_ns,p999_ns\n";
+        for (const auto& result : results)
+        {
+            file << result.lock << ',' << result.config.threads << ',' << result.config.criticalSection << ',' << result.config.thinkTime << ','
+                 << std::fixed << std::setprecision(0) << result.throughput << ','
+                 << result.p50 << ',' << result.p99 << ',' << result.p999 << '\n';
+        }
+    }
+
+    void WriteJson(const std::string& path, const std::vector<Result>& results)
+    {
+        std::ofstream file(path);
+        file << "[\n";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& result = results[i];
+            file << "  {\"lock\": \"" << result.lock << "\", \"threads\": " << result.config.threads
+                 << ", \"critical_section\": " << result.config.criticalSection << ", \"think_time\": " << result.config.thinkTime
+                 << ", \"throughput\": " << std::fixed << std::setprecision(0) << result.throughput
+                 << ", \"p50_ns\": " << result.p50 << ", \"p99_ns\": " << result.p99 << ", \"p999_ns\": " << result.p999 << "}"
+                 << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        file << "]\n";
+    }
+}
+
+namespace BENCHMARK
+{
+    void Start(const std::string& csvPath, const std::string& jsonPath)
+    {
+        std::cout << "Замеры блокировок" << std::endl;
+
+        std::vector<Config> configs;
+        for (int threads = 1; threads <= (int)std::max(std::thread::hardware_concurrency(), 1u); threads *= 2)
+            for (int criticalSection : CRITICAL_SECTIONS)
+                for (int thinkTime : THINK_TIMES)
+                    configs.push_back({ threads, criticalSection, thinkTime });
+
+        std::vector<Result> results;
+        auto Add = [&](Result result)
+        {
+            std::cout << std::left << std::setw(36) << result.lock << std::right
+                      << " threads = " << std::setw(3) << result.config.threads
+                      << ", cs = " << std::setw(3) << result.config.criticalSection
+                      << ", think = " << std::setw(3) << result.config.thinkTime
+                      << ": " << std::fixed << std::setprecision(0) << std::setw(12) << result.throughput << " захватов/сек"
+                      << ", p50 = " << result.p50 << " нс, p99 = " << result.p99 << " нс, p99.9 = " << result.p999 << " нс" << std::endl;
+            results.push_back(std::move(result));
+        };
+
+        for (const auto& config : configs)
+        {
+            // Spinlock
+            Add(Run<EXAMPLE::atomic::compare_exchange_strong::Spinlock, SpinlockGuard<EXAMPLE::atomic::compare_exchange_strong::Spinlock>>("compare_exchange_strong::Spinlock", config));
+            Add(Run<EXAMPLE::atomic::compare_exchange_weak::Spinlock, SpinlockGuard<EXAMPLE::atomic::compare_exchange_weak::Spinlock>>("compare_exchange_weak::Spinlock", config));
+            Add(Run<EXAMPLE::atomic::wait::Spinlock, SpinlockGuard<EXAMPLE::atomic::wait::Spinlock>>("wait::Spinlock", config));
+            Add(Run<EXAMPLE::atomic_flag::Spinlock, SpinlockGuard<EXAMPLE::atomic_flag::Spinlock>>("atomic_flag::Spinlock", config));
+            Add(Run<EXAMPLE::cv::Spinlock, SpinlockGuard<EXAMPLE::cv::Spinlock>>("cv::Spinlock", config));
+            Add(Run<TTAS::Spinlock, std::lock_guard<TTAS::Spinlock>>("TTAS::Spinlock", config));
+            Add(Run<TICKET::Spinlock, std::lock_guard<TICKET::Spinlock>>("TICKET::Spinlock", config));
+            Add(Run<MCS::Spinlock, MCS::Spinlock::Guard>("MCS::Spinlock", config));
+            Add(Run<ADAPTIVE::Spinlock, std::lock_guard<ADAPTIVE::Spinlock>>("ADAPTIVE::Spinlock", config));
+            // std
+            Add(Run<std::mutex, std::lock_guard<std::mutex>>("std::mutex", config));
+            Add(Run<std::shared_mutex, std::lock_guard<std::shared_mutex>>("std::shared_mutex", config));
+            Add(Run<std::shared_mutex, std::shared_lock<std::shared_mutex>>("std::shared_mutex (shared)", config, false));
+            Add(Run<shared_recursive_mutex, std::lock_guard<shared_recursive_mutex>>("shared_recursive_mutex", config));
+            Add(Run<BIG_READER::shared_mutex, std::lock_guard<BIG_READER::shared_mutex>>("BIG_READER::shared_mutex", config));
+            Add(Run<BIG_READER::shared_mutex, std::shared_lock<BIG_READER::shared_mutex>>("BIG_READER::shared_mutex (shared)", config, false));
+            Add(Run<RW_POLICY::shared_mutex<RWPolicy::READER_PREFERRING>, std::shared_lock<RW_POLICY::shared_mutex<RWPolicy::READER_PREFERRING>>>("READER_PREFERRING (shared)", config, false));
+            Add(Run<RW_POLICY::shared_mutex<RWPolicy::WRITER_PREFERRING>, std::shared_lock<RW_POLICY::shared_mutex<RWPolicy::WRITER_PREFERRING>>>("WRITER_PREFERRING (shared)", config, false));
+            Add(Run<RW_POLICY::shared_mutex<RWPolicy::PHASE_FAIR>, std::shared_lock<RW_POLICY::shared_mutex<RWPolicy::PHASE_FAIR>>>("PHASE_FAIR (shared)", config, false));
+#if defined(_MSC_VER) || defined(_MSC_FULL_VER) || defined(_WIN32) || defined(_WIN64)
+            // tbb
+            Add(Run<tbb::spin_mutex, tbb::spin_mutex::scoped_lock>("tbb::spin_mutex", config));
+            Add(Run<tbb::queuing_mutex, tbb::queuing_mutex::scoped_lock>("tbb::queuing_mutex", config));
+            Add(Run<tbb::spin_rw_mutex, tbb::spin_rw_mutex::scoped_lock>("tbb::spin_rw_mutex", config));
+            Add(Run<tbb::spin_rw_mutex, SpinRWReadLock>("tbb::spin_rw_mutex (shared)", config, false));
+#endif
+        }
+
+        WriteCsv(csvPath, results);
+        WriteJson(jsonPath, results);
+        std::cout << "Результаты: " << csvPath << ", " << jsonPath << std::endl;
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,12 @@
+#ifndef Benchmark_hpp
+#define Benchmark_hpp
+
+#include <string>
+
+namespace BENCHMARK
+{
+    // Замеры всех блокировок, результаты записываются в csvPath и jsonPath
+    void Start(const std::string& csvPath = "locks.csv", const std::string& jsonPath = "locks.json");
+}
+
+#endif /* Benchmark_hpp */
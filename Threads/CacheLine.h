@@ -0,0 +1,127 @@
+#ifndef CacheLine_h
+#define CacheLine_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/*
+ Кэш-линия (cache line) - минимальный блок памяти, которым обмениваются кэши ядер процессора (x86-64 - 64 байта, Apple Silicon - 128 байт).
+ False sharing (ложное разделение) - два потока пишут в РАЗНЫЕ переменные, которые лежат в ОДНОЙ кэш-линии, поэтому ядра постоянно отбирают друг у друга эту кэш-линию, хотя данные не пересекаются.
+ Решение: выравнивать часто изменяемые переменные разных потоков по границе кэш-линии - alignas(CACHE_LINE_SIZE).
+ Замечание: std::hardware_destructive_interference_size поддерживается не всеми компиляторами (в xcode нет), поэтому размер задается вручную.
+ */
+#if defined(__APPLE__) && defined(__aarch64__)
+    inline constexpr std::size_t CACHE_LINE_SIZE = 128;
+#else
+    inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+#endif
+
+/*
+ Обертка, которая занимает целую кэш-линию (выравнивание + размер кратный CACHE_LINE_SIZE), поэтому соседние элементы массива Padded<T> не делят кэш-линию.
+ Например, std::vector<Padded<std::atomic<int>>> - счетчики потоков без false sharing.
+ */
+template <typename T>
+struct alignas(CACHE_LINE_SIZE) Padded
+{
+    T value{};
+    
+    T& operator*() noexcept { return value; }
+    const T& operator*() const noexcept { return value; }
+    T* operator->() noexcept { return &value; }
+    const T* operator->() const noexcept { return &value; }
+};
+
+namespace thread_index
+{
+    // Номера потоков: следующий новый номер и свободные номера завершенных потоков (min-heap)
+    class Pool
+    {
+    public:
+        static Pool& Instance()
+        {
+            static Pool pool;
+            return pool;
+        }
+        
+        // false - номер не выдан (ошибка мьютекса или нет памяти)
+        bool Acquire(size_t& index) noexcept
+        {
+            try
+            {
+                std::lock_guard lock(_mutex);
+                if (_free.empty())
+                {
+                    _free.reserve(_next + 1); // Release не выделяет память: свободных номеров не больше выданных
+                    index = _next++;
+                    return true;
+                }
+                std::pop_heap(_free.begin(), _free.end(), std::greater<>());
+                index = _free.back();
+                _free.pop_back();
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }
+        
+        void Release(size_t index) noexcept
+        {
+            try
+            {
+                std::lock_guard lock(_mutex);
+                _free.push_back(index);
+                std::push_heap(_free.begin(), _free.end(), std::greater<>());
+            }
+            catch (...) // номер не вернется в пул: корректно, но номера станут менее плотными
+            {
+            }
+        }
+    
+    private:
+        std::mutex _mutex;
+        std::vector<size_t> _free;
+        size_t _next = 0;
+    };
+    
+    // Номер текущего потока, освобождается при завершении потока
+    struct Holder
+    {
+        // Номер не выдан - запасной номер по хэшу id потока (не плотный, в пул не возвращается), поэтому ThreadIndex не бросает исключений
+        Holder() noexcept : pooled(Pool::Instance().Acquire(index))
+        {
+            if (!pooled)
+                index = std::hash<std::thread::id>()(std::this_thread::get_id());
+        }
+        ~Holder()
+        {
+            if (pooled)
+                Pool::Instance().Release(index);
+        }
+        
+        size_t index = 0;
+        const bool pooled;
+    };
+}
+
+/*
+ Номер потока: наименьший свободный номер (0, 1, 2, ...), выдается при первом вызове в потоке. Используется для выбора "своей" ячейки (шарда, счетчика) без конкуренции с другими потоками.
+ При завершении потока номер освобождается и достается следующему новому потоку, поэтому номера живых потоков плотные: пока живых потоков не больше N, их номера % N не совпадают, даже если потоки постоянно создаются и завершаются (std::async, пулы потоков).
+ Ограничение: если живых потоков больше N, то потоки с одинаковым ThreadIndex() % N делят ячейку (корректно, но с конкуренцией).
+ Цена: мьютекс только при первом вызове и при завершении потока, далее - чтение thread_local.
+ Не бросает исключений: если номер выдать не удалось (нет памяти), используется хэш id потока - корректно, но с возможной конкуренцией.
+ */
+inline size_t ThreadIndex() noexcept
+{
+    thread_local const thread_index::Holder holder;
+    return holder.index;
+}
+
+#endif /* CacheLine_h */
@@ -1,4 +1,5 @@
 #include "Condition_Variable.hpp"
+#include "Spinlock.h"
 
 #include <condition_variable>
 #include <iostream>
@@ -8,40 +9,6 @@
 #include <shared_mutex>
 #include <vector>
 
-namespace cv
-{
-    class Spinlock
-    {
-        Spinlock(const Spinlock&) = delete;
-        
-    public:
-        Spinlock() = default;
-        ~Spinlock() = default;
-        
-        void Lock() noexcept
-        {
-            std::unique_lock lock(_mutex);
-            _cv.wait(lock, [this] { return !_flag.exchange(true); });
-        }
-        
-        bool Try_lock() noexcept
-        {
-            return !_flag.exchange(true);
-        }
-        
-        void Unlock() noexcept
-        {
-            _cv.notify_one();
-            _flag = false;
-        }
-        
-    private:
-        std::atomic<bool> _flag;
-        std::mutex _mutex;
-        std::condition_variable _cv;
-    };
-}
-
 template <class TSpinlock>
 void PrintSymbol(char c, TSpinlock& spinlock)
 {
@@ -261,7 +228,7 @@ namespace cv
             {
                 std::cout << "Spinlock" << std::endl;
                 
-                cv::Spinlock spinlock;
+                EXAMPLE::cv::Spinlock spinlock;
                 std::thread thread1([&] {PrintSymbol('+', spinlock);});
                 std::thread thread2([&] {PrintSymbol('-', spinlock);});
                 
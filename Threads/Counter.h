@@ -0,0 +1,72 @@
+#ifndef Counter_h
+#define Counter_h
+
+#include "CacheLine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+/*
+ Шардированный счетчик (striped counter, аналог LongAdder в Java) - замена общего std::atomic<int> для часто изменяемых счетчиков (кол-во запросов, байтов и т.д.).
+ Проблема: ++std::atomic<int> - это lock xadd над ОДНОЙ кэш-линией, поэтому при записи из многих ядер кэш-линия постоянно перебрасывается между ядрами и каждый инкремент ждет ее, пропускная способность падает с ростом кол-ва ядер.
+ Решение:
+ 1. у каждого потока своя ячейка (по номеру потока ThreadIndex), каждая ячейка в своей кэш-линии (Padded) - инкремент не конкурирует с другими потоками.
+ 2. инкремент с memory_order_relaxed: счетчик не синхронизирует другие данные.
+ 3. сумма вычисляется лениво при чтении (Sum) - обход всех ячеек.
+ Номера завершенных потоков переиспользуются (ThreadIndex), поэтому пока живых потоков не больше кол-ва ячеек, ячейки не делятся. Если живых потоков больше, то ячейку делят потоки с одинаковым ThreadIndex() % кол-во ячеек (корректно, но с конкуренцией).
+ Замечание: Sum не атомарен относительно одновременных Add - возвращает значение между суммой до и после этих Add, поэтому подходит для статистики, но не для условий вида "если счетчик == N".
+ */
+template <typename T = int64_t>
+class ShardedCounter
+{
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+    
+public:
+    // Кол-во ячеек по-умолчанию - кол-во аппаратных потоков: потоки с номерами 0..cells-1 не пересекаются
+    explicit ShardedCounter(size_t cells = std::max(std::thread::hardware_concurrency(), 1u)) : _cells(cells)
+    {}
+    ~ShardedCounter() = default;
+    
+    void Add(T value) noexcept
+    {
+        // LOAD (yes) ↑ STORE (yes)
+        _cells[ThreadIndex() % _cells.size()]->fetch_add(value, std::memory_order_relaxed);
+        // LOAD (yes) ↓ STORE (yes)
+    }
+    
+    ShardedCounter& operator++() noexcept
+    {
+        Add(1);
+        return *this;
+    }
+    
+    ShardedCounter& operator+=(T value) noexcept
+    {
+        Add(value);
+        return *this;
+    }
+    
+    T Sum() const noexcept
+    {
+        T sum = 0;
+        for (const auto& cell : _cells)
+            sum += cell->load(std::memory_order_relaxed);
+        return sum;
+    }
+    
+    void Reset() noexcept
+    {
+        for (auto& cell : _cells)
+            cell->store(0, std::memory_order_relaxed);
+    }
+    
+private:
+    std::vector<Padded<std::atomic<T>>> _cells;
+};
+
+#endif /* Counter_h */
@@ -0,0 +1,278 @@
+#ifndef Epoch_h
+#define Epoch_h
+
+#include "CacheLine.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+
+/*
+ EBR (epoch-based reclamation) - освобождение памяти по эпохам для lock-free структур.
+ Проблема: в lock-free структуре поток A удалил узел из структуры (unlink), но поток B еще мог прочитать указатель на этот узел раньше и сейчас обращается к нему. Если A сразу вызовет delete, то B обратится к освобожденной памяти (use-after-free). mutex решает проблему, но делает структуру блокирующей.
+ Решение: узел удаляется не сразу, а откладывается (Retire) до тех пор, пока все потоки, которые могли его видеть, не выйдут из критических секций чтения.
+ Принцип работы:
+ 1. Глобальная эпоха _epoch - счетчик, который только растет.
+ 2. У каждого потока свой слот (в своей кэш-линии): при входе в критическую секцию чтения (EpochGuard) поток записывает в слот текущую глобальную эпоху, при выходе - INACTIVE.
+ 3. Retire - узел попадает в список отложенных узлов потока с текущей глобальной эпохой.
+ 4. Глобальная эпоха увеличивается на 1 (TryAdvance), только если все активные потоки уже находятся в текущей эпохе. Продвижение эпохи только читает слоты и никогда не ждет читателей: если кто-то отстает, то попытка просто не удается.
+ 5. Узел, отложенный в эпоху e, освобождается, когда глобальная эпоха >= e + 2: все потоки, которые могли его видеть, вышли из критических секций.
+ 6. Освобождение пачками (BATCH): продвижение эпохи и проход по списку - раз в BATCH вызовов Retire.
+ Использование:
+     {
+         EBR::EpochGuard guard;        // критическая секция чтения
+         Node* node = head.load();     // node не будет освобожден, пока guard жив
+         ...
+     }
+     EBR::Retire(node);                // после удаления узла из структуры
+ Замечание: поток, который долго находится внутри EpochGuard, останавливает продвижение эпохи, поэтому отложенные узлы копятся (память растет, но не освобождается раньше времени).
+ Ограничение: одновременно не больше MAX_THREADS потоков (слот освобождается при завершении потока), иначе EpochGuard/Retire бросают std::system_error.
+ */
+namespace EBR
+{
+    class Domain
+    {
+        Domain(const Domain&) = delete;
+        Domain& operator=(const Domain&) = delete;
+
+        static constexpr uint64_t INACTIVE = ~uint64_t(0);
+        static constexpr size_t MAX_THREADS = 256;
+        static constexpr size_t BATCH = 64;
+
+        struct Retired
+        {
+            void* pointer;
+            void (*deleter)(void*);
+            uint64_t epoch;
+        };
+
+        struct alignas(CACHE_LINE_SIZE) Slot
+        {
+            std::atomic<uint64_t> epoch = INACTIVE;
+            std::atomic<bool> used = false;
+        };
+
+        // Состояние потока: номер слота, вложенность EpochGuard, отложенные узлы
+        struct ThreadState
+        {
+            explicit ThreadState(Domain& domain) : domain(domain), slot(domain.AcquireSlot()) {}
+            ~ThreadState()
+            {
+                domain.ReleaseThread(*this);
+            }
+
+            Domain& domain;
+            size_t slot;
+            int nesting = 0;
+            std::vector<Retired> retired;
+        };
+
+    public:
+        static Domain& Instance()
+        {
+            static Domain domain;
+            return domain;
+        }
+
+        ~Domain()
+        {
+            for (const auto& retired : _orphans)
+                retired.deleter(retired.pointer);
+        }
+
+        // Первый вызов в потоке занимает слот: std::system_error, если потоков больше, чем MAX_THREADS
+        void Enter()
+        {
+            ThreadState& state = Local();
+            if (state.nesting++ > 0) // вложенный EpochGuard
+                return;
+
+            _slots[state.slot].epoch.store(_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            // Запись слота должна стать видна другим потокам раньше, чем поток прочитает указатели структуры (STORE -> LOAD)
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        void Exit() noexcept
+        {
+            ThreadState& state = Local();
+            if (--state.nesting > 0)
+                return;
+
+            // LOAD (yes) ↑ STORE (no)
+            _slots[state.slot].epoch.store(INACTIVE, std::memory_order_release);
+            // LOAD (no) ↓ STORE (no)
+        }
+
+        // Вызывается после удаления узла из структуры
+        void Retire(void* pointer, void (*deleter)(void*))
+        {
+            ThreadState& state = Local();
+            state.retired.push_back({ pointer, deleter, _epoch.load(std::memory_order_seq_cst) });
+            _pending.fetch_add(1, std::memory_order_relaxed);
+            if (state.retired.size() % BATCH == 0)
+                Collect(state);
+        }
+
+        // Продвижение эпохи + освобождение отложенных узлов текущего потока
+        void Collect()
+        {
+            Collect(Local());
+        }
+
+        /*
+         Ожидание, пока эпоха продвинется на 2, и освобождение всех отложенных узлов текущего потока и завершенных потоков.
+         Блокирует только вызывающий поток, нельзя вызывать внутри EpochGuard.
+         */
+        void Synchronize()
+        {
+            ThreadState& state = Local();
+            assert(state.nesting == 0 && "EBR::Synchronize внутри EpochGuard");
+
+            const uint64_t target = _epoch.load(std::memory_order_seq_cst) + 2;
+            while (_epoch.load(std::memory_order_seq_cst) < target)
+            {
+                if (!TryAdvance())
+                    std::this_thread::yield();
+            }
+            Collect(state);
+        }
+
+        uint64_t Epoch() const noexcept
+        {
+            return _epoch.load(std::memory_order_relaxed);
+        }
+
+        // Кол-во отложенных, но еще не освобожденных объектов всех потоков
+        size_t Pending() const noexcept
+        {
+            return _pending.load(std::memory_order_relaxed);
+        }
+
+    private:
+        Domain() = default;
+
+        ThreadState& Local()
+        {
+            thread_local ThreadState state(*this);
+            return state;
+        }
+
+        size_t AcquireSlot()
+        {
+            for (size_t i = 0; i < MAX_THREADS; ++i)
+            {
+                bool expected = false;
+                if (!_slots[i].used.load(std::memory_order_relaxed) && _slots[i].used.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                {
+                    // Граница просмотра слотов в TryAdvance
+                    size_t count = _slotCount.load(std::memory_order_relaxed);
+                    while (count < i + 1 && !_slotCount.compare_exchange_weak(count, i + 1, std::memory_order_release, std::memory_order_relaxed));
+                    return i;
+                }
+            }
+            // Слот освобождается при завершении потока, поэтому ошибка исправима: поток может повторить попытку позже
+            throw std::system_error(std::make_error_code(std::errc::resource_unavailable_try_again), "EBR: потоков, использующих EpochGuard/Retire одновременно, больше, чем MAX_THREADS = " + std::to_string(MAX_THREADS));
+        }
+
+        // Завершение потока: оставшиеся отложенные узлы передаются другим потокам (_orphans), слот освобождается
+        void ReleaseThread(ThreadState& state)
+        {
+            Collect(state);
+            if (!state.retired.empty())
+            {
+                std::lock_guard lock(_mutex);
+                _orphans.insert(_orphans.end(), state.retired.begin(), state.retired.end());
+                _hasOrphans.store(true, std::memory_order_release);
+            }
+            _slots[state.slot].epoch.store(INACTIVE, std::memory_order_release);
+            _slots[state.slot].used.store(false, std::memory_order_release);
+        }
+
+        // Продвижение эпохи: только чтение слотов, читатели не ждут
+        bool TryAdvance() noexcept
+        {
+            uint64_t epoch = _epoch.load(std::memory_order_seq_cst);
+            for (size_t i = 0, count = _slotCount.load(std::memory_order_acquire); i < count; ++i)
+            {
+                const uint64_t local = _slots[i].epoch.load(std::memory_order_seq_cst);
+                if (local != INACTIVE && local != epoch) // поток еще в предыдущей эпохе
+                    return false;
+            }
+            // Неудача - эпоху уже продвинул другой поток, результат тот же
+            _epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+            return true;
+        }
+
+        void Collect(ThreadState& state)
+        {
+            TryAdvance();
+
+            // Узлы завершенных потоков
+            if (_hasOrphans.load(std::memory_order_acquire))
+            {
+                std::lock_guard lock(_mutex);
+                state.retired.insert(state.retired.end(), _orphans.begin(), _orphans.end());
+                _orphans.clear();
+                _hasOrphans.store(false, std::memory_order_relaxed);
+            }
+
+            const uint64_t epoch = _epoch.load(std::memory_order_seq_cst);
+            auto safe = std::partition(state.retired.begin(), state.retired.end(), [epoch](const Retired& retired) { return retired.epoch + 2 > epoch; });
+            for (auto it = safe; it != state.retired.end(); ++it)
+                it->deleter(it->pointer);
+            _pending.fetch_sub(state.retired.end() - safe, std::memory_order_relaxed);
+            state.retired.erase(safe, state.retired.end());
+        }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> _epoch = 0;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _slotCount = 0;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _pending = 0;
+        std::array<Slot, MAX_THREADS> _slots;
+        std::mutex _mutex;
+        std::vector<Retired> _orphans;
+        std::atomic<bool> _hasOrphans = false;
+    };
+
+    // RAII критическая секция чтения
+    class EpochGuard
+    {
+        EpochGuard(const EpochGuard&) = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+
+    public:
+        EpochGuard() : _domain(Domain::Instance())
+        {
+            _domain.Enter();
+        }
+
+        ~EpochGuard() noexcept
+        {
+            _domain.Exit();
+        }
+
+    private:
+        Domain& _domain;
+    };
+
+    template <typename T>
+    void Retire(T* pointer)
+    {
+        Domain::Instance().Retire(pointer, [](void* pointer) { delete static_cast<T*>(pointer); });
+    }
+
+    inline void Synchronize()
+    {
+        Domain::Instance().Synchronize();
+    }
+}
+
+#endif /* Epoch_h */
@@ -0,0 +1,275 @@
+#ifndef HazardPointer_h
+#define HazardPointer_h
+
+#include "CacheLine.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+
+/*
+ Hazard pointers (опасные указатели) - освобождение памяти для lock-free структур с ограниченным объемом неосвобожденной памяти.
+ Проблема EBR (Epoch.h): один остановившийся (вытесненный, зависший) читатель внутри EpochGuard останавливает продвижение эпохи, поэтому ВСЕ отложенные объекты копятся без ограничения.
+ Решение: поток защищает не "все, что он мог видеть", а конкретные указатели:
+ 1. У каждого потока SLOTS слотов (hazard pointers), каждый слот в своей кэш-линии.
+ 2. Protect - поток записывает указатель в свой слот и перепроверяет, что указатель все еще в структуре. Пока указатель в слоте, объект не будет освобожден.
+ 3. Retire - объект попадает в список отложенных объектов потока. Когда список достигает порога (2 * кол-во слотов всех потоков, но не меньше MIN_THRESHOLD), выполняется Scan: собираются все указатели из слотов, освобождаются отложенные объекты, которых нет среди защищенных.
+ Ограничение памяти: у потока не больше порог + кол-во защищенных объектов неосвобожденных объектов, независимо от того, сколько длится остановка читателя.
+ Цена: Protect на каждое чтение указателя - запись + барьер памяти (дороже, чем EpochGuard на всю операцию).
+ Использование:
+     HP::HazardPointer hazard;
+     Node* node = hazard.Protect(head);   // node не будет освобожден, пока он в hazard
+     ...
+     HP::Retire(node);                    // после удаления узла из структуры
+ Ограничение: у потока одновременно не больше SLOTS объектов HazardPointer, потоков - не больше MAX_THREADS (запись освобождается при завершении потока), иначе конструктор HazardPointer бросает std::system_error.
+ */
+namespace HP
+{
+    class Domain
+    {
+        Domain(const Domain&) = delete;
+        Domain& operator=(const Domain&) = delete;
+
+    public:
+        static constexpr size_t MAX_THREADS = 256;
+        static constexpr size_t SLOTS = 4; // hazard pointers на поток
+
+    private:
+        static constexpr size_t MIN_THRESHOLD = 64;
+
+        struct Retired
+        {
+            void* pointer;
+            void (*deleter)(void*);
+        };
+
+        struct alignas(CACHE_LINE_SIZE) Slot
+        {
+            std::atomic<void*> pointer = nullptr;
+        };
+
+        struct Record
+        {
+            std::array<Slot, SLOTS> slots;
+            std::atomic<bool> used = false;
+        };
+
+        // Состояние потока: номер записи, занятые слоты (битовая маска), отложенные объекты
+        struct ThreadState
+        {
+            explicit ThreadState(Domain& domain) : domain(domain), record(domain.AcquireRecord()) {}
+            ~ThreadState()
+            {
+                domain.ReleaseThread(*this);
+            }
+
+            Domain& domain;
+            size_t record;
+            uint32_t busy = 0;
+            std::vector<Retired> retired;
+        };
+
+    public:
+        static Domain& Instance()
+        {
+            static Domain domain;
+            return domain;
+        }
+
+        ~Domain()
+        {
+            for (const auto& retired : _orphans)
+                retired.deleter(retired.pointer);
+        }
+
+        // Свободный слот текущего потока: std::system_error, если заняты все SLOTS слотов потока или потоков больше, чем MAX_THREADS
+        std::atomic<void*>& AcquireSlot()
+        {
+            ThreadState& state = Local();
+            for (size_t i = 0; i < SLOTS; ++i)
+            {
+                if (!(state.busy & (1u << i)))
+                {
+                    state.busy |= 1u << i;
+                    return _records[state.record].slots[i].pointer;
+                }
+            }
+            throw std::system_error(std::make_error_code(std::errc::resource_unavailable_try_again), "HP: у потока заняты все SLOTS = " + std::to_string(SLOTS) + " hazard pointers");
+        }
+
+        void ReleaseSlot(std::atomic<void*>& slot) noexcept
+        {
+            ThreadState& state = Local();
+            // LOAD (yes) ↑ STORE (no)
+            slot.store(nullptr, std::memory_order_release);
+            // LOAD (no) ↓ STORE (no)
+            auto& slots = _records[state.record].slots;
+            for (size_t i = 0; i < SLOTS; ++i)
+            {
+                if (&slots[i].pointer == &slot)
+                    state.busy &= ~(1u << i);
+            }
+        }
+
+        // Вызывается после удаления объекта из структуры
+        void Retire(void* pointer, void (*deleter)(void*))
+        {
+            ThreadState& state = Local();
+            state.retired.push_back({ pointer, deleter });
+            _pending.fetch_add(1, std::memory_order_relaxed);
+            if (state.retired.size() >= Threshold())
+                Scan(state);
+        }
+
+        // Кол-во отложенных, но еще не освобожденных объектов всех потоков
+        size_t Pending() const noexcept
+        {
+            return _pending.load(std::memory_order_relaxed);
+        }
+
+    private:
+        Domain() = default;
+
+        ThreadState& Local()
+        {
+            thread_local ThreadState state(*this);
+            return state;
+        }
+
+        // Порог Scan: 2 * кол-во слотов, тогда хотя бы половина отложенных объектов освобождается за один Scan
+        size_t Threshold() const noexcept
+        {
+            return std::max(MIN_THRESHOLD, 2 * SLOTS * _recordCount.load(std::memory_order_relaxed));
+        }
+
+        size_t AcquireRecord()
+        {
+            for (size_t i = 0; i < MAX_THREADS; ++i)
+            {
+                bool expected = false;
+                if (!_records[i].used.load(std::memory_order_relaxed) && _records[i].used.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                {
+                    size_t count = _recordCount.load(std::memory_order_relaxed);
+                    while (count < i + 1 && !_recordCount.compare_exchange_weak(count, i + 1, std::memory_order_release, std::memory_order_relaxed));
+                    return i;
+                }
+            }
+            throw std::system_error(std::make_error_code(std::errc::resource_unavailable_try_again), "HP: потоков, использующих hazard pointers одновременно, больше, чем MAX_THREADS = " + std::to_string(MAX_THREADS));
+        }
+
+        // Завершение потока: оставшиеся отложенные объекты передаются другим потокам (_orphans), запись освобождается
+        void ReleaseThread(ThreadState& state)
+        {
+            for (auto& slot : _records[state.record].slots)
+                slot.pointer.store(nullptr, std::memory_order_release);
+            Scan(state);
+            if (!state.retired.empty())
+            {
+                std::lock_guard lock(_mutex);
+                _orphans.insert(_orphans.end(), state.retired.begin(), state.retired.end());
+                _hasOrphans.store(true, std::memory_order_release);
+            }
+            _records[state.record].used.store(false, std::memory_order_release);
+        }
+
+        void Scan(ThreadState& state)
+        {
+            // Объекты завершенных потоков
+            if (_hasOrphans.load(std::memory_order_acquire))
+            {
+                std::lock_guard lock(_mutex);
+                state.retired.insert(state.retired.end(), _orphans.begin(), _orphans.end());
+                _orphans.clear();
+                _hasOrphans.store(false, std::memory_order_relaxed);
+            }
+
+            // Отложенный объект был удален из структуры раньше, поэтому Protect, записавший указатель позже, не пройдет перепроверку
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::vector<void*> hazards;
+            hazards.reserve(SLOTS * _recordCount.load(std::memory_order_acquire));
+            for (size_t i = 0, count = _recordCount.load(std::memory_order_acquire); i < count; ++i)
+            {
+                for (const auto& slot : _records[i].slots)
+                {
+                    if (void* pointer = slot.pointer.load(std::memory_order_seq_cst))
+                        hazards.push_back(pointer);
+                }
+            }
+            std::sort(hazards.begin(), hazards.end());
+
+            auto safe = std::partition(state.retired.begin(), state.retired.end(), [&hazards](const Retired& retired)
+                {
+                    return std::binary_search(hazards.begin(), hazards.end(), retired.pointer); // защищен - оставляем
+                });
+            for (auto it = safe; it != state.retired.end(); ++it)
+                it->deleter(it->pointer);
+            _pending.fetch_sub(state.retired.end() - safe, std::memory_order_relaxed);
+            state.retired.erase(safe, state.retired.end());
+        }
+
+    private:
+        std::array<Record, MAX_THREADS> _records;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _recordCount = 0;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _pending = 0;
+        std::mutex _mutex;
+        std::vector<Retired> _orphans;
+        std::atomic<bool> _hasOrphans = false;
+    };
+
+    // RAII hazard pointer: занимает слот текущего потока на время жизни
+    class HazardPointer
+    {
+        HazardPointer(const HazardPointer&) = delete;
+        HazardPointer& operator=(const HazardPointer&) = delete;
+
+    public:
+        HazardPointer() : _slot(Domain::Instance().AcquireSlot()) {}
+        ~HazardPointer() noexcept
+        {
+            Domain::Instance().ReleaseSlot(_slot);
+        }
+
+        // Защищенное чтение: указатель записывается в слот и перепроверяется, что source не изменился
+        template <typename T>
+        T* Protect(const std::atomic<T*>& source) noexcept
+        {
+            T* pointer = source.load(std::memory_order_relaxed);
+            while (true)
+            {
+                // seq_cst запись + seq_cst чтение: запись слота не опускается ниже перепроверки (STORE -> LOAD), Scan увидит слот
+                // LOAD (no) ↑ STORE (no)
+                _slot.store(pointer, std::memory_order_seq_cst);
+                T* current = source.load(std::memory_order_seq_cst);
+                // LOAD (no) ↓ STORE (no)
+                if (current == pointer)
+                    return pointer;
+
+                pointer = current;
+            }
+        }
+
+        void Reset() noexcept
+        {
+            // LOAD (yes) ↑ STORE (no)
+            _slot.store(nullptr, std::memory_order_release);
+            // LOAD (no) ↓ STORE (no)
+        }
+
+    private:
+        std::atomic<void*>& _slot;
+    };
+
+    template <typename T>
+    void Retire(T* pointer)
+    {
+        Domain::Instance().Retire(pointer, [](void* pointer) { delete static_cast<T*>(pointer); });
+    }
+}
+
+#endif /* HazardPointer_h */
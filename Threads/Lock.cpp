@@ -1,9 +1,13 @@
 #include "Lock.hpp"
+#include "SharedMutex.h"
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <mutex>
 #include <shared_mutex>
 #include <thread>
+#include <vector>
 
 
 /*
@@ -235,6 +239,68 @@ namespace LOCK
             thread4.join();
             thread5.join();
             
+            std::cout << std::endl;
+        }
+        /*
+         Политика блокировки чтения/записи (RW_POLICY::shared_mutex<RWPolicy>, SharedMutex.h): непрерывный поток читателей и редкий писатель.
+         У std::shared_mutex политику выбирает платформа (glibc - приоритет читателей, писатель может ждать секунды), здесь политика явная, а время ожидания видно в Statistics.
+         */
+        {
+            std::cout << "Политика блокировки чтения/записи: 4 непрерывных читателя, 1 писатель" << std::endl;
+            
+            auto Run = [](const char* name, auto& mutex)
+            {
+                constexpr int writes = 20;
+                const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2); // ограничение, если писатель голодает
+                std::atomic<bool> done = false;
+                std::atomic<int64_t> sum = 0;
+                int number = 0;
+                
+                std::vector<std::thread> readers;
+                for (int i = 0; i < 4; ++i)
+                {
+                    readers.emplace_back([&]()
+                        {
+                            int64_t local = 0;
+                            while (!done && std::chrono::steady_clock::now() < deadline)
+                            {
+                                std::shared_lock lock(mutex);
+                                local += number;
+                                std::this_thread::sleep_for(std::chrono::microseconds(100)); // чтение
+                            }
+                            sum += local;
+                        });
+                }
+                std::thread writer([&]()
+                    {
+                        for (int i = 0; i < writes; ++i)
+                        {
+                            std::unique_lock lock(mutex);
+                            ++number;
+                        }
+                        done = true;
+                    });
+                
+                writer.join();
+                for (auto& reader : readers)
+                {
+                    reader.join();
+                }
+                
+                const auto statistics = mutex.Statistics();
+                std::cout << name << ": чтений = " << statistics.readers.acquisitions
+                          << ", ожидание писателя: среднее = " << std::chrono::duration_cast<std::chrono::microseconds>(statistics.writers.Average()).count()
+                          << " мкс, максимум = " << std::chrono::duration_cast<std::chrono::microseconds>(statistics.writers.max).count()
+                          << " мкс, ожидание читателя: максимум = " << std::chrono::duration_cast<std::chrono::microseconds>(statistics.readers.max).count() << " мкс" << std::endl;
+            };
+            
+            RW_POLICY::shared_mutex<RWPolicy::READER_PREFERRING> readerPreferring;
+            RW_POLICY::shared_mutex<RWPolicy::WRITER_PREFERRING> writerPreferring;
+            RW_POLICY::shared_mutex<RWPolicy::PHASE_FAIR> phaseFair;
+            Run("READER_PREFERRING", readerPreferring);
+            Run("WRITER_PREFERRING", writerPreferring);
+            Run("PHASE_FAIR", phaseFair);
+            
             std::cout << std::endl;
         }
     }
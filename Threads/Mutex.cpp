@@ -1,11 +1,17 @@
 #include "Mutex.hpp"
+#include "ProfiledMutex.h"
+#include "SharedMutex.h"
+#include "shared_recursive_mutex.h"
 
+#include <chrono>
 #include <iostream>
 #include <functional>
+#include <map>
 #include <mutex>
 #include <ranges>
 #include <thread>
 #include <shared_mutex>
+#include <vector>
 
 
 /*
@@ -449,6 +455,101 @@ namespace MUTEX
                 
                 std::cout << std::endl;
             }
+            /*
+             Big-reader lock (BIG_READER::shared_mutex): у каждого потока свой счетчик читателей в своей кэш-линии, писатель обходит все счетчики.
+             std::shared_mutex при каждом чтении меняет один общий счетчик, поэтому при большом кол-ве ядер чтение перестает масштабироваться.
+             */
+            {
+                std::cout << "Big-reader lock: 1 запись на 1000 чтений" << std::endl;
+                
+                // Кол-во операций в секунду: threads потоков читают number, каждая 1000-я операция - запись
+                auto ReadMostly = [](auto& mutex, int threads)->double
+                {
+                    constexpr int count = 200000;
+                    int number = 0;
+                    std::atomic<int64_t> sum = 0;
+                    std::vector<std::thread> workers;
+                    
+                    const auto start = std::chrono::steady_clock::now();
+                    for (int i = 0; i < threads; ++i)
+                    {
+                        workers.emplace_back([&]()
+                            {
+                                int64_t local = 0;
+                                for (int j = 1; j <= count; ++j)
+                                {
+                                    if (j % 1000 == 0)
+                                    {
+                                        std::unique_lock lock(mutex);
+                                        ++number;
+                                    }
+                                    else
+                                    {
+                                        std::shared_lock lock(mutex);
+                                        local += number;
+                                    }
+                                }
+                                sum += local;
+                            });
+                    }
+                    for (auto& worker : workers)
+                    {
+                        worker.join();
+                    }
+                    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    return threads * count / std::max(seconds, 0.001);
+                };
+                
+                for (int threads : { 1, 4, 16 })
+                {
+                    std::shared_mutex sharedMutex;
+                    BIG_READER::shared_mutex bigReaderMutex;
+                    std::cout << "потоков: " << threads << std::endl;
+                    std::cout << "std::shared_mutex: " << ReadMostly(sharedMutex, threads) << " операций/сек" << std::endl;
+                    std::cout << "BIG_READER::shared_mutex: " << ReadMostly(bigReaderMutex, threads) << " операций/сек" << std::endl;
+                }
+                
+                std::cout << std::endl;
+            }
+            /*
+             shared_recursive_mutex - рекурсивное чтение/запись и повышение чтения до записи без освобождения блокировки.
+             Без повышения поток освобождает чтение и захватывает запись заново, поэтому между ними другой писатель может изменить данные и прочитанное нужно перепроверять.
+             */
+            {
+                std::cout << "shared_recursive_mutex: рекурсивное чтение и повышение до записи" << std::endl;
+                big_reader_shared_recursive_mutex mutex;
+                int number = 0;
+                
+                std::function<int(int)> Read = [&](int depth)->int
+                {
+                    std::shared_lock lock(mutex); // повторный захват чтения - только счетчик потока
+                    return depth > 0 ? Read(depth - 1) : number;
+                };
+                
+                // Увеличение, если число четное: проверка под чтением, запись после повышения (значение не могло измениться)
+                auto IncrementEven = [&]()
+                {
+                    mutex.lock_upgrade();
+                    if (Read(3) % 2 == 0)
+                    {
+                        mutex.upgrade();
+                        ++number;
+                        mutex.downgrade();
+                    }
+                    mutex.unlock_upgrade();
+                };
+                
+                std::thread thread1(IncrementEven);
+                std::thread thread2(IncrementEven);
+                std::thread thread3([&]() { Read(5); });
+                
+                thread1.join();
+                thread2.join();
+                thread3.join();
+                
+                std::cout << "number: " << number << " (ровно одно увеличение)" << std::endl;
+                std::cout << std::endl;
+            }
         }
         /*
          std::shared_timed_mutex - обладает свойствами std::shared_mutex + std::timed_mutex.
@@ -509,5 +610,58 @@ namespace MUTEX
             
             std::cout << std::endl;
         }
+        /*
+         ProfiledMutex<M> - профилирование блокировок (ProfiledMutex.h): кол-во захватов, конкуренция, время ожидания и удержания по местам блокировки.
+         Включено при LOCK_PROFILING = 1 (флаг компилятора, по умолчанию выключено), иначе ProfiledMutex<M> - обычный M без накладных расходов.
+         */
+        {
+            std::cout << "ProfiledMutex: профилирование блокировок" << std::endl;
+            ProfiledMutex<std::mutex> cache("Cache::Insert"); // долгая критическая секция - конкуренция
+            ProfiledMutex<std::recursive_mutex> tree("Tree::Visit");
+            ProfiledMutex<std::shared_timed_mutex> config("Config");
+            std::map<int, int> values;
+            int config_value = 0;
+            
+            // Visit(3): 1 захват (acquired) + 3 повторных захвата владельцем (reentered)
+            std::function<void(int)> Visit = [&](int depth)
+            {
+                std::lock_guard lock(tree);
+                if (depth > 0)
+                    Visit(depth - 1);
+            };
+            
+            auto Function = [&](int thread)
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    {
+                        std::lock_guard lock(cache);
+                        values[thread * 1000 + i] = i;
+                        std::this_thread::sleep_for(std::chrono::microseconds(10));
+                    }
+                    Visit(3);
+                    if (i % 100 == 0)
+                    {
+                        std::unique_lock lock(config);
+                        ++config_value;
+                    }
+                    else
+                    {
+                        std::shared_lock lock(config);
+                        [[maybe_unused]] int value = config_value;
+                    }
+                }
+            };
+            
+            std::vector<std::thread> threads;
+            for (int i = 0; i < 4; ++i)
+                threads.emplace_back(Function, i);
+            for (auto& thread : threads)
+                thread.join();
+            
+            profiler::Report(std::cout);
+            profiler::ReportJson(std::cout);
+            std::cout << std::endl;
+        }
     }
 }
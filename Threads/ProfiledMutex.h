@@ -0,0 +1,488 @@
+#ifndef ProfiledMutex_h
+#define ProfiledMutex_h
+
+#include "CacheLine.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+/*
+ Профилирование блокировок: ProfiledMutex<M> - обертка над мьютексом M (std::mutex, std::recursive_mutex, std::timed_mutex, std::shared_timed_mutex, ...), которая для каждого места блокировки (site - имя, переданное в конструктор) собирает:
+ - кол-во захватов (acquisitions) и кол-во захватов с конкуренцией (contended): мьютекс был занят (try_lock не удался);
+ - кол-во повторных захватов владельцем (reentries) у рекурсивного мьютекса: считаются отдельно, т.к. не ждут и не конкурируют;
+ - суммарное и максимальное время ожидания захвата;
+ - суммарное и максимальное время удержания (hold) монопольной блокировки, у общей (lock_shared) - только ожидание.
+ Метрики пишутся в буфер текущего потока без блокировок и атомарных RMW (у каждого счетчика один писатель). При завершении потока его метрики переносятся в общие метрики завершенных потоков, а буфер удаляется, поэтому в отчет попадают и завершенные потоки, а память не растет с кол-вом созданных потоков.
+ Отчет по запросу: profiler::Snapshot - метрики мест блокировки всех потоков, отсортированные по времени ожидания, profiler::Report - таблица, profiler::ReportJson - JSON.
+ Включение: LOCK_PROFILING = 1 (по умолчанию 0) - одинаково для всех единиц трансляции программы, например, флагом компилятора. При LOCK_PROFILING = 0 ProfiledMutex<M> - это M (наследник без полей), накладных расходов нет.
+ Замечание: значение по умолчанию не зависит от NDEBUG, т.к. размер ProfiledMutex<M> зависит от LOCK_PROFILING: единицы трансляции с разными NDEBUG видели бы разные классы с одним именем (нарушение ODR).
+ Использование:
+     ProfiledMutex<std::mutex> mutex("Cache::Insert");
+     std::lock_guard lock(mutex);
+     ...
+     profiler::Report(std::cout);
+ */
+#ifndef LOCK_PROFILING
+    #define LOCK_PROFILING 0
+#endif
+
+namespace profiler
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Метрики места блокировки
+    struct SiteStatistics
+    {
+        std::string site;
+        uint64_t acquisitions = 0;
+        uint64_t contended = 0;
+        uint64_t reentries = 0;
+        std::chrono::nanoseconds waitTotal{ 0 };
+        std::chrono::nanoseconds waitMax{ 0 };
+        std::chrono::nanoseconds holdTotal{ 0 };
+        std::chrono::nanoseconds holdMax{ 0 };
+    };
+
+#if LOCK_PROFILING
+    // Счетчики места блокировки в буфере потока: пишет только поток-владелец, читает отчет
+    struct Counters
+    {
+        std::atomic<const char*> site = nullptr;
+        std::atomic<uint64_t> acquisitions = 0;
+        std::atomic<uint64_t> contended = 0;
+        std::atomic<uint64_t> reentries = 0;
+        std::atomic<uint64_t> waitTotal = 0;
+        std::atomic<uint64_t> waitMax = 0;
+        std::atomic<uint64_t> holdTotal = 0;
+        std::atomic<uint64_t> holdMax = 0;
+
+        // Один писатель: чтение + запись вместо fetch_add
+        static void Add(std::atomic<uint64_t>& counter, uint64_t value) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        static void Max(std::atomic<uint64_t>& counter, uint64_t value) noexcept
+        {
+            if (value > counter.load(std::memory_order_relaxed))
+                counter.store(value, std::memory_order_relaxed);
+        }
+
+        void OnAcquired(bool contended, Clock::duration wait) noexcept
+        {
+            const uint64_t waited = std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count();
+            Add(acquisitions, 1);
+            if (contended)
+            {
+                Add(this->contended, 1);
+                Add(waitTotal, waited);
+                Max(waitMax, waited);
+            }
+        }
+
+        void OnFailed() noexcept
+        {
+            Add(contended, 1);
+        }
+
+        void OnReentered() noexcept
+        {
+            Add(reentries, 1);
+        }
+
+        void OnReleased(Clock::duration hold) noexcept
+        {
+            const uint64_t held = std::chrono::duration_cast<std::chrono::nanoseconds>(hold).count();
+            Add(holdTotal, held);
+            Max(holdMax, held);
+        }
+    };
+
+    // Буфер потока: открытая адресация по указателю на имя места блокировки
+    class ThreadBuffer
+    {
+        static constexpr size_t SITES = 64; // степень двойки
+
+    public:
+        Counters& Find(const char* site) noexcept
+        {
+            size_t index = (reinterpret_cast<uintptr_t>(site) >> 3) & (SITES - 1);
+            for (size_t i = 0; i < SITES; ++i, index = (index + 1) & (SITES - 1))
+            {
+                const char* key = _sites[index].site.load(std::memory_order_relaxed);
+                if (key == site)
+                    return _sites[index];
+
+                if (key == nullptr)
+                {
+                    // LOAD (yes) ↑ STORE (yes): отчет увидит обнуленные счетчики вместе с именем
+                    _sites[index].site.store(site, std::memory_order_release);
+                    return _sites[index];
+                }
+            }
+            return _overflow; // мест блокировки больше, чем SITES
+        }
+
+        template <typename TFunction>
+        void ForEach(TFunction&& function) const
+        {
+            for (const auto& counters : _sites)
+            {
+                if (const char* site = counters.site.load(std::memory_order_acquire))
+                    function(site, counters);
+            }
+            if (_overflow.acquisitions.load(std::memory_order_relaxed) || _overflow.contended.load(std::memory_order_relaxed))
+                function("(переполнение)", _overflow);
+        }
+
+    private:
+        std::array<Counters, SITES> _sites;
+        Counters _overflow;
+    };
+
+    // Буферы живых потоков и метрики завершенных: мьютекс только при регистрации и завершении потока и при отчете
+    class Registry
+    {
+        Registry(const Registry&) = delete;
+        Registry& operator=(const Registry&) = delete;
+
+    public:
+        static Registry& Instance()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        ThreadBuffer& Local()
+        {
+            thread_local const Holder holder(*this);
+            return *holder.buffer;
+        }
+
+        std::vector<SiteStatistics> Snapshot()
+        {
+            std::lock_guard lock(_mutex);
+            std::map<std::string, SiteStatistics> sites = _retired;
+            for (const auto& buffer : _buffers)
+                Merge(sites, *buffer);
+
+            std::vector<SiteStatistics> result;
+            result.reserve(sites.size());
+            for (auto& [site, statistics] : sites)
+            {
+                statistics.site = site;
+                result.push_back(std::move(statistics));
+            }
+            return result;
+        }
+
+    private:
+        // Буфер потока: регистрируется при первой блокировке в потоке, при завершении потока сворачивается в _retired
+        struct Holder
+        {
+            explicit Holder(Registry& registry) : registry(registry), buffer(registry.Register()) {}
+            ~Holder()
+            {
+                registry.Unregister(buffer);
+            }
+
+            Registry& registry;
+            ThreadBuffer* buffer;
+        };
+
+        Registry() = default;
+
+        // Одно имя места блокировки может быть разными строками в разных единицах трансляции, поэтому объединение по содержимому
+        static void Merge(std::map<std::string, SiteStatistics>& sites, const ThreadBuffer& buffer)
+        {
+            using std::chrono::nanoseconds;
+
+            buffer.ForEach([&sites](const char* site, const Counters& counters)
+                {
+                    SiteStatistics& statistics = sites[site];
+                    statistics.acquisitions += counters.acquisitions.load(std::memory_order_relaxed);
+                    statistics.contended += counters.contended.load(std::memory_order_relaxed);
+                    statistics.reentries += counters.reentries.load(std::memory_order_relaxed);
+                    statistics.waitTotal += nanoseconds(counters.waitTotal.load(std::memory_order_relaxed));
+                    statistics.waitMax = std::max(statistics.waitMax, nanoseconds(counters.waitMax.load(std::memory_order_relaxed)));
+                    statistics.holdTotal += nanoseconds(counters.holdTotal.load(std::memory_order_relaxed));
+                    statistics.holdMax = std::max(statistics.holdMax, nanoseconds(counters.holdMax.load(std::memory_order_relaxed)));
+                });
+        }
+
+        ThreadBuffer* Register()
+        {
+            auto buffer = std::make_unique<ThreadBuffer>();
+            std::lock_guard lock(_mutex);
+            return _buffers.emplace_back(std::move(buffer)).get();
+        }
+
+        // Завершение потока: счетчики переносятся в _retired, буфер удаляется - память и время Snapshot не растут с кол-вом завершенных потоков
+        void Unregister(ThreadBuffer* buffer)
+        {
+            std::lock_guard lock(_mutex);
+            Merge(_retired, *buffer);
+            auto it = std::find_if(_buffers.begin(), _buffers.end(), [buffer](const auto& pointer) { return pointer.get() == buffer; });
+            std::swap(*it, _buffers.back());
+            _buffers.pop_back();
+        }
+
+    private:
+        std::mutex _mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> _buffers; // буферы живых потоков
+        std::map<std::string, SiteStatistics> _retired; // метрики завершенных потоков
+    };
+#endif
+
+    // Метрики всех мест блокировки, самые долгие ожидания - первые
+    inline std::vector<SiteStatistics> Snapshot()
+    {
+#if LOCK_PROFILING
+        auto result = Registry::Instance().Snapshot();
+        std::sort(result.begin(), result.end(), [](const SiteStatistics& left, const SiteStatistics& right)
+            {
+                return left.waitTotal != right.waitTotal ? left.waitTotal > right.waitTotal : left.holdTotal > right.holdTotal;
+            });
+        return result;
+#else
+        return {};
+#endif
+    }
+
+    inline void Report(std::ostream& stream)
+    {
+        using std::chrono::microseconds;
+        using std::chrono::duration_cast;
+
+        if (!LOCK_PROFILING)
+        {
+            stream << "Профилирование блокировок выключено (LOCK_PROFILING = 0)" << std::endl;
+            return;
+        }
+
+        stream << std::left << std::setw(32) << "site" << std::right
+               << std::setw(12) << "acquired" << std::setw(12) << "contended" << std::setw(12) << "reentered"
+               << std::setw(14) << "wait, мкс" << std::setw(16) << "max wait, мкс" << std::setw(14) << "hold, мкс" << std::setw(16) << "max hold, мкс" << std::endl;
+        for (const auto& statistics : Snapshot())
+        {
+            stream << std::left << std::setw(32) << statistics.site << std::right
+                   << std::setw(12) << statistics.acquisitions << std::setw(12) << statistics.contended << std::setw(12) << statistics.reentries
+                   << std::setw(14) << duration_cast<microseconds>(statistics.waitTotal).count() << std::setw(16) << duration_cast<microseconds>(statistics.waitMax).count()
+                   << std::setw(14) << duration_cast<microseconds>(statistics.holdTotal).count() << std::setw(16) << duration_cast<microseconds>(statistics.holdMax).count() << std::endl;
+        }
+    }
+
+    // Строка JSON: экранирование кавычек, обратной косой черты и управляющих символов, UTF-8 без изменений
+    inline void WriteJsonString(std::ostream& stream, const std::string& string)
+    {
+        constexpr char HEX[] = "0123456789abcdef";
+        stream << '"';
+        for (const char symbol : string)
+        {
+            switch (symbol)
+            {
+                case '"': stream << "\\\""; break;
+                case '\\': stream << "\\\\"; break;
+                case '\b': stream << "\\b"; break;
+                case '\f': stream << "\\f"; break;
+                case '\n': stream << "\\n"; break;
+                case '\r': stream << "\\r"; break;
+                case '\t': stream << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(symbol) < 0x20)
+                        stream << "\\u00" << HEX[symbol >> 4] << HEX[symbol & 0xF];
+                    else
+                        stream << symbol;
+            }
+        }
+        stream << '"';
+    }
+
+    inline void ReportJson(std::ostream& stream)
+    {
+        const auto sites = Snapshot();
+        stream << "[\n";
+        for (size_t i = 0; i < sites.size(); ++i)
+        {
+            const auto& statistics = sites[i];
+            stream << "  {\"site\": ";
+            WriteJsonString(stream, statistics.site);
+            stream << ", \"acquisitions\": " << statistics.acquisitions << ", \"contended\": " << statistics.contended << ", \"reentries\": " << statistics.reentries
+                   << ", \"wait_total_ns\": " << statistics.waitTotal.count() << ", \"wait_max_ns\": " << statistics.waitMax.count()
+                   << ", \"hold_total_ns\": " << statistics.holdTotal.count() << ", \"hold_max_ns\": " << statistics.holdMax.count() << "}"
+                   << (i + 1 < sites.size() ? "," : "") << "\n";
+        }
+        stream << "]\n";
+    }
+}
+
+#if LOCK_PROFILING
+/*
+ Профилируемый мьютекс: сначала try_lock, при неудаче - захват с замером ожидания (конкуренция).
+ Время удержания: момент захвата хранится в мьютексе (его меняет только владелец), для рекурсивного мьютекса - от первого захвата до последнего освобождения.
+ Рекурсивный мьютекс: захватом считается только первый захват владельцем (_depth 0 -> 1), повторные - reentries.
+ Неудачный try_lock (try_lock_for, try_lock_until) считается конкуренцией без захвата.
+ */
+template <class M>
+class ProfiledMutex
+{
+    ProfiledMutex(const ProfiledMutex&) = delete;
+    ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+public:
+    explicit ProfiledMutex(const char* site = "unnamed") noexcept : _site(site) {}
+
+    void lock()
+    {
+        profiler::Counters& counters = Counters();
+        if (_mutex.try_lock())
+        {
+            OnLocked(counters, false, {});
+        }
+        else
+        {
+            const auto start = profiler::Clock::now();
+            _mutex.lock();
+            OnLocked(counters, true, profiler::Clock::now() - start);
+        }
+    }
+
+    bool try_lock()
+    {
+        profiler::Counters& counters = Counters();
+        if (!_mutex.try_lock())
+        {
+            counters.OnFailed();
+            return false;
+        }
+        OnLocked(counters, false, {});
+        return true;
+    }
+
+    template <class Rep, class Period>
+    bool try_lock_for(const std::chrono::duration<Rep, Period>& duration) requires requires(M mutex) { mutex.try_lock_for(std::chrono::duration<Rep, Period>()); }
+    {
+        return TimedLock([&]() { return _mutex.try_lock_for(duration); });
+    }
+
+    template <class TClock, class Duration>
+    bool try_lock_until(const std::chrono::time_point<TClock, Duration>& time) requires requires(M mutex) { mutex.try_lock_until(std::chrono::time_point<TClock, Duration>()); }
+    {
+        return TimedLock([&]() { return _mutex.try_lock_until(time); });
+    }
+
+    void unlock()
+    {
+        if (--_depth == 0) // до освобождения: после него _acquired меняет новый владелец
+            Counters().OnReleased(profiler::Clock::now() - _acquired);
+        _mutex.unlock();
+    }
+
+    void lock_shared() requires requires(M mutex) { mutex.lock_shared(); }
+    {
+        profiler::Counters& counters = Counters();
+        if (_mutex.try_lock_shared())
+        {
+            counters.OnAcquired(false, {});
+            return;
+        }
+
+        const auto start = profiler::Clock::now();
+        _mutex.lock_shared();
+        counters.OnAcquired(true, profiler::Clock::now() - start);
+    }
+
+    bool try_lock_shared() requires requires(M mutex) { mutex.try_lock_shared(); }
+    {
+        if (!_mutex.try_lock_shared())
+        {
+            Counters().OnFailed();
+            return false;
+        }
+        Counters().OnAcquired(false, {});
+        return true;
+    }
+
+    void unlock_shared() requires requires(M mutex) { mutex.unlock_shared(); }
+    {
+        _mutex.unlock_shared();
+    }
+
+    const char* Site() const noexcept
+    {
+        return _site;
+    }
+
+private:
+    profiler::Counters& Counters() noexcept
+    {
+        return profiler::Registry::Instance().Local().Find(_site);
+    }
+
+    // Вызывается под блокировкой: _depth > 0 - мьютекс уже у текущего потока (рекурсия)
+    void OnLocked(profiler::Counters& counters, bool contended, profiler::Clock::duration wait) noexcept
+    {
+        if (_depth++ > 0)
+        {
+            counters.OnReentered();
+            return;
+        }
+        counters.OnAcquired(contended, wait);
+        _acquired = profiler::Clock::now();
+    }
+
+    template <typename TFunction>
+    bool TimedLock(TFunction&& function)
+    {
+        profiler::Counters& counters = Counters();
+        if (_mutex.try_lock())
+        {
+            OnLocked(counters, false, {});
+            return true;
+        }
+
+        const auto start = profiler::Clock::now();
+        if (!function())
+        {
+            counters.OnFailed();
+            return false;
+        }
+        OnLocked(counters, true, profiler::Clock::now() - start);
+        return true;
+    }
+
+private:
+    M _mutex;
+    const char* _site;
+    int _depth = 0; // захваты владельцем (рекурсия), меняется только под блокировкой
+    profiler::Clock::time_point _acquired;
+};
+#else
+// Профилирование выключено: тот же мьютекс M без полей и проверок
+template <class M>
+class ProfiledMutex : public M
+{
+public:
+    explicit ProfiledMutex(const char* = nullptr) noexcept {}
+
+    const char* Site() const noexcept
+    {
+        return nullptr;
+    }
+};
+
+static_assert(sizeof(ProfiledMutex<std::mutex>) == sizeof(std::mutex), "ProfiledMutex: без LOCK_PROFILING не должно быть накладных расходов");
+#endif
+
+#endif /* ProfiledMutex_h */
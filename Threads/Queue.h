@@ -1,10 +1,186 @@
 #ifndef ThreadSafeQueue_h
 #define ThreadSafeQueue_h
 
+#include "CacheLine.h"
+#include "HazardPointer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <random>
 #include <shared_mutex>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/*
+ Пустой член класса (политика без данных) не занимает памяти. MSVC игнорирует стандартный [[no_unique_address]], поэтому для него [[msvc::no_unique_address]].
+ */
+#if defined(_MSC_VER)
+    #define NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+    #define NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+/*
+ Статистика очереди - политика (policy), которая передается шаблонным параметром в MUTEX::ThreadSafeQueue/SHARED_MUTEX::ThreadSafeQueue:
+ - NoStatistics (по-умолчанию) - все методы пустые, элемент хранится без метки времени, поэтому статистика компилируется в ничто.
+ - QueueStatistics - собирает метрики:
+   1. максимальная глубина очереди (high-water mark).
+   2. гистограмма задержек от Push до Pop (бакет i - задержка < 2^i нс).
+   3. кол-во Pop, которые ждали на пустой очереди.
+   4. кол-во захватов mutex с конкуренцией (try_lock не удался).
+   Счетчики хранятся в ячейках по номеру потока (каждая ячейка в своей кэш-линии), поэтому сбор статистики не добавляет конкуренции. Snapshot суммирует ячейки.
+ */
+struct NoStatistics
+{
+    template <typename T>
+    using Entry = T;
+    
+    template <class TQueue, typename U>
+    static void Emplace(TQueue& queue, U&& value)
+    {
+        queue.emplace(std::forward<U>(value));
+    }
+    
+    template <typename T>
+    static T& Value(T& entry) noexcept
+    {
+        return entry;
+    }
+    
+    template <class TLock>
+    static void Lock(TLock& lock)
+    {
+        lock.lock();
+    }
+    
+    static void OnPush(size_t, size_t = 1) noexcept {}
+    template <typename T>
+    static void OnPop(const T&) noexcept {}
+    static void OnBlockedPop() noexcept {}
+};
 
+class QueueStatistics
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t BUCKETS = 40;
+    
+    struct Report
+    {
+        size_t maxDepth = 0;
+        uint64_t pushes = 0;
+        uint64_t pops = 0;
+        uint64_t blockedPops = 0;
+        uint64_t contended = 0;
+        std::array<uint64_t, BUCKETS> latency{}; // бакет i - задержка < 2^i нс
+    };
+    
+    template <typename T>
+    using Entry = std::pair<T, Clock::time_point>; // элемент + время Push
+    
+    template <class TQueue, typename U>
+    static void Emplace(TQueue& queue, U&& value)
+    {
+        queue.emplace(std::forward<U>(value), Clock::now());
+    }
+    
+    template <typename T>
+    static T& Value(Entry<T>& entry) noexcept
+    {
+        return entry.first;
+    }
+    
+    // Захват с подсчетом конкуренции: сначала try_lock, при неудаче - обычный lock
+    template <class TLock>
+    void Lock(TLock& lock)
+    {
+        if (lock.try_lock())
+            return;
+        
+        Increment(Local().contended);
+        lock.lock();
+    }
+    
+    void OnPush(size_t depth, size_t count = 1) noexcept
+    {
+        Slot& slot = Local();
+        slot.pushes.fetch_add(count, std::memory_order_relaxed);
+        // Ячейку могут делить потоки (ThreadIndex() % SLOTS), поэтому максимум через compare_exchange, а не чтение + запись
+        size_t maxDepth = slot.maxDepth.load(std::memory_order_relaxed);
+        while (depth > maxDepth && !slot.maxDepth.compare_exchange_weak(maxDepth, depth, std::memory_order_relaxed));
+    }
+    
+    template <typename T>
+    void OnPop(const Entry<T>& entry) noexcept
+    {
+        const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - entry.second).count();
+        Slot& slot = Local();
+        Increment(slot.pops);
+        Increment(slot.latency[std::min<size_t>(std::bit_width((uint64_t)std::max<int64_t>(latency, 0)), BUCKETS - 1)]);
+    }
+    
+    void OnBlockedPop() noexcept
+    {
+        Increment(Local().blockedPops);
+    }
+    
+    Report Snapshot() const noexcept
+    {
+        Report report;
+        for (const auto& slot : _slots)
+        {
+            report.maxDepth = std::max(report.maxDepth, slot.maxDepth.load(std::memory_order_relaxed));
+            report.pushes += slot.pushes.load(std::memory_order_relaxed);
+            report.pops += slot.pops.load(std::memory_order_relaxed);
+            report.blockedPops += slot.blockedPops.load(std::memory_order_relaxed);
+            report.contended += slot.contended.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < BUCKETS; ++i)
+                report.latency[i] += slot.latency[i].load(std::memory_order_relaxed);
+        }
+        return report;
+    }
+    
+private:
+    struct alignas(CACHE_LINE_SIZE) Slot
+    {
+        std::atomic<uint64_t> pushes;
+        std::atomic<uint64_t> pops;
+        std::atomic<uint64_t> blockedPops;
+        std::atomic<uint64_t> contended;
+        std::atomic<size_t> maxDepth;
+        std::array<std::atomic<uint64_t>, BUCKETS> latency;
+    };
+    
+    Slot& Local() noexcept
+    {
+        return _slots[ThreadIndex() % SLOTS];
+    }
+    
+    // Ячейку почти всегда меняет только свой поток, поэтому fetch_add без конкуренции
+    static void Increment(std::atomic<uint64_t>& counter) noexcept
+    {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+private:
+    static constexpr size_t SLOTS = 64;
+    
+    std::array<Slot, SLOTS> _slots{};
+};
 
 /*
  Потокобезопасная очередь - позволяет безопасно нескольким потоков получать доступ к элементам очереди без необходимости синхронизации (синхронизация внутри структуры).
@@ -16,49 +192,194 @@ namespace MUTEX
      condition_variable используется для ожидания изменений в очереди:
      1. когда поток добавляет элемент в очередь, то он подает сигнал об этом condition_variable.
      2. когда поток пытается удалить элемент из очереди, то он должен сначала проверить, пуста ли очередь - это гарантия, что поток не удалит элемент из пустой очереди. Если очередь пуста, то он ждет сигнала от condition_variable, пока элемент не будет добавлен в очередь.
+     Close - закрытие очереди: будит все ожидающие потоки, новые элементы не принимаются, Pop дочитывает оставшиеся элементы и затем возвращает пустой std::optional. Читатели завершаются без специальных сообщений-маркеров и опроса (polling).
+     TStatistics - статистика очереди (NoStatistics/QueueStatistics).
      */
-    template <typename T>
+    template <typename T, class TStatistics = NoStatistics>
     class ThreadSafeQueue
     {
     public:
         
-        void Push(T&& value)
+        // false - очередь закрыта, элемент не добавлен
+        bool Push(T&& value)
         {
-            std::lock_guard lock(_mutex);
-            _queue.push(std::forward<T>(value));
+            std::unique_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
+            if (_closed)
+                return false;
+            
+            _statistics.Emplace(_queue, std::forward<T>(value));
+            _statistics.OnPush(_queue.size());
             _cv.notify_one(); // Уведомить один ожижающий поток, что он может удалить элемент
+            return true;
         }
 
-        T Pop()
+        // Пустой std::optional - очередь закрыта и пуста
+        std::optional<T> Pop()
         {
-            std::unique_lock lock(_mutex);
+            std::unique_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
+            if (_queue.empty() && !_closed)
+                _statistics.OnBlockedPop();
             /*
              Тоже самое, что:
-             while (_queue.empty())
+             while (_queue.empty() && !_closed)
                  cv.wait(lock);
              */
-            _cv.wait(lock, [this]() { return !_queue.empty(); }); // если очередь пуста, то ждем
-            T item = _queue.front();
-            _queue.pop();
-            return item;
+            _cv.wait(lock, [this]() { return !_queue.empty() || _closed; }); // если очередь пуста, то ждем
+            return Take();
         }
         
-        bool Empty()
+        // Не блокирует поток: проверка и извлечение за 1 захват mutex, false - очередь пуста
+        bool TryPop(T& value)
+        {
+            std::unique_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
+            if (auto item = Take())
+            {
+                value = std::move(*item);
+                return true;
+            }
+            return false;
+        }
+        
+        // Ждет элемент не дольше timeout: false - время вышло или очередь закрыта
+        template <class Rep, class Period>
+        bool WaitPopFor(T& value, const std::chrono::duration<Rep, Period>& timeout)
+        {
+            std::unique_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
+            if (_queue.empty() && !_closed)
+                _statistics.OnBlockedPop();
+            _cv.wait_for(lock, timeout, [this]() { return !_queue.empty() || _closed; });
+            if (auto item = Take())
+            {
+                value = std::move(*item);
+                return true;
+            }
+            return false;
+        }
+        
+        void Close()
+        {
+            {
+                std::lock_guard lock(_mutex);
+                _closed = true;
+            }
+            _cv.notify_all(); // Разбудить всех ожидающих читателей
+        }
+        
+        bool Closed()
         {
             std::lock_guard lock(_mutex);
+            return _closed;
+        }
+        
+        /*
+         Пакетная запись: все элементы [first, last) перемещаются в очередь под одной блокировкой, потом одно уведомление.
+         Для пачки сообщений вместо N захватов mutex и N notify_one - 1 захват и 1 notify.
+         */
+        template <class TIterator>
+        bool PushRange(TIterator first, TIterator last)
+        {
+            size_t count = 0;
+            {
+                std::unique_lock lock(_mutex, std::defer_lock);
+                _statistics.Lock(lock);
+                if (_closed)
+                    return false;
+                
+                for (; first != last; ++first, ++count)
+                    _statistics.Emplace(_queue, std::move(*first));
+                _statistics.OnPush(_queue.size(), count);
+            }
+            
+            if (count == 1)
+                _cv.notify_one();
+            else if (count > 1)
+                _cv.notify_all(); // элементов несколько - их могут забрать несколько читателей
+            return true;
+        }
+        
+        /*
+         Пакетное чтение: ждет хотя бы один элемент, затем под одной блокировкой перемещает до count элементов в out.
+         Память не выделяется - out указывает на буфер вызывающего (например, std::span или std::vector заранее нужного размера).
+         Возвращает кол-во прочитанных элементов, 0 - очередь закрыта и пуста.
+         */
+        template <class TOutputIterator>
+        size_t PopBulk(TOutputIterator out, size_t count)
+        {
+            if (count == 0)
+                return 0;
+            
+            std::unique_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
+            if (_queue.empty() && !_closed)
+                _statistics.OnBlockedPop();
+            _cv.wait(lock, [this]() { return !_queue.empty() || _closed; }); // если очередь пуста, то ждем
+            size_t size = std::min(count, _queue.size());
+            for (size_t i = 0; i < size; ++i, ++out)
+                *out = std::move(*Take());
+            return size;
+        }
+        
+        size_t PopBulk(std::span<T> items)
+        {
+            return PopBulk(items.begin(), items.size());
+        }
+        
+        bool Empty()
+        {
+            std::unique_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
             return _queue.empty();
         }
         
+        const TStatistics& Statistics() const noexcept
+        {
+            return _statistics;
+        }
+        
     private:
-        std::queue<T> _queue;
+        // Вызывается под _mutex
+        std::optional<T> Take()
+        {
+            if (_queue.empty())
+                return std::nullopt;
+            
+            auto& entry = _queue.front();
+            _statistics.OnPop(entry);
+            std::optional<T> item(std::move(_statistics.Value(entry))); // перемещение, а не копирование: для std::string/буферов копия - выделение памяти
+            _queue.pop();
+            return item;
+        }
+        
+    private:
+        std::queue<typename TStatistics::template Entry<T>> _queue;
         std::mutex _mutex;
         std::condition_variable _cv;
+        bool _closed = false;
+        NO_UNIQUE_ADDRESS TStatistics _statistics;
+    };
+    
+    // NoStatistics не занимает памяти: размер как у очереди без статистики
+    struct BaselineLayout
+    {
+        std::queue<int> queue;
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool closed;
     };
+    static_assert(sizeof(ThreadSafeQueue<int, NoStatistics>) == sizeof(BaselineLayout), "MUTEX::ThreadSafeQueue: NoStatistics не должна занимать памяти");
 }
 
 namespace SHARED_MUTEX
 {
-    template <class T>
+    /*
+     TStatistics - статистика очереди (NoStatistics/QueueStatistics), Pop не ждет, поэтому кол-во ожидавших Pop всегда 0.
+     TSharedMutex - блокировка чтения/записи: политику std::shared_mutex выбирает платформа, RW_POLICY::shared_mutex<RWPolicy> - явная политика (SharedMutex.h).
+     */
+    template <class T, class TStatistics = NoStatistics, class TSharedMutex = std::shared_mutex>
     class ThreadSafeQueue
     {
     public:
@@ -67,50 +388,1085 @@ namespace SHARED_MUTEX
         
         T Back()
         {
-            std::shared_lock lock(_mutex);
-            return _queue.back();
+            std::shared_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
+            return _statistics.Value(_queue.back());
         }
         
         T Front()
         {
-            std::shared_lock lock(_mutex);
-            return _queue.front();
+            std::shared_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
+            return _statistics.Value(_queue.front());
         }
         
         bool Empty()
         {
-            std::shared_lock lock(_mutex);
+            std::shared_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
             return _queue.empty();
         }
         
         size_t Size()
         {
-            std::shared_lock lock(_mutex);
-            return _queue.Size();
+            std::shared_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
+            return _queue.size();
         }
 
         void Push(T&& value)
         {
-            std::unique_lock lock(_mutex);
-            _queue.push(std::forward<T>(value));
+            std::unique_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
+            _statistics.Emplace(_queue, std::forward<T>(value));
+            _statistics.OnPush(_queue.size());
         };
         
         void Pop()
         {
-            std::unique_lock lock(_mutex);
+            std::unique_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
+            _statistics.OnPop(_queue.front());
             _queue.pop();
         };
         
         void Clear()
         {
-            std::unique_lock lock(_mutex);
+            std::unique_lock lock(_mutex, std::defer_lock);
+            _statistics.Lock(lock);
             if (!_queue.empty())
                 _queue.pop();
         };
+        
+        const TStatistics& Statistics() const noexcept
+        {
+            return _statistics;
+        }
+
+    private:
+        std::queue<typename TStatistics::template Entry<T>> _queue;
+        TSharedMutex _mutex;
+        NO_UNIQUE_ADDRESS TStatistics _statistics;
+    };
+    
+    // NoStatistics не занимает памяти: размер как у очереди без статистики
+    struct BaselineLayout
+    {
+        std::queue<int> queue;
+        std::shared_mutex mutex;
+    };
+    static_assert(sizeof(ThreadSafeQueue<int, NoStatistics>) == sizeof(BaselineLayout), "SHARED_MUTEX::ThreadSafeQueue: NoStatistics не должна занимать памяти");
+}
+
+/*
+ Signal - ожидание изменений без mutex и condition_variable на std::atomic::wait (C++20, под капотом futex в Linux / ulock в macOS):
+ 1. spin - изменение часто происходит за доли микросекунды, поэтому засыпать сразу невыгодно.
+ 2. сон на счетчике пробуждений _signal - поток регистрируется в _sleepers, поэтому Notify делает системный вызов только при наличии спящих.
+ Барьеры (seq_cst fence) в Wait и Notify образуют пару: либо Notify увидит спящего, либо спящий после регистрации увидит изменения - пробуждение не теряется.
+ */
+class Signal
+{
+public:
+    // function - попытка выполнить операцию: true - выполнена, false - нужно ждать
+    template <class TFunction>
+    void Wait(TFunction&& function)
+    {
+        for (int i = 0; i < SPIN_COUNT; ++i)
+        {
+            if (function())
+                return;
+            std::this_thread::yield();
+        }
+        
+        for (;;)
+        {
+            uint32_t signal = _signal.load(std::memory_order_relaxed);
+            _sleepers.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool done = function();
+            if (!done)
+                _signal.wait(signal, std::memory_order_relaxed);
+            _sleepers.fetch_sub(1, std::memory_order_relaxed);
+            if (done)
+                return;
+        }
+    }
+    
+    void NotifyOne() noexcept
+    {
+        if (HasSleepers())
+            _signal.notify_one();
+    }
+    
+    void NotifyAll() noexcept
+    {
+        if (HasSleepers())
+            _signal.notify_all();
+    }
+    
+private:
+    bool HasSleepers() noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_sleepers.load(std::memory_order_relaxed) == 0)
+            return false;
+        
+        _signal.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    
+private:
+    static constexpr int SPIN_COUNT = 64;
+    
+    std::atomic<uint32_t> _sleepers = 0; // кол-во спящих потоков
+    std::atomic<uint32_t> _signal = 0; // счетчик пробуждений
+};
+
+/*
+ Lock-free очередь MPMC (multi-producer/multi-consumer, Дмитрий Вьюков) - ограниченный кольцевой буфер без mutex.
+ Размер буфера - степень двойки, поэтому индекс ячейки вычисляется маской: pos & _mask.
+ В каждой ячейке хранится номер последовательности (sequence), который говорит, чья сейчас очередь:
+ - sequence == pos - ячейка свободна, в нее может записать писатель с позицией pos.
+ - sequence == pos + 1 - ячейка заполнена, из нее может прочитать читатель с позицией pos.
+ Писатели соревнуются только за _enqueuePos, читатели - только за _dequeuePos, каждый счетчик лежит в своей кэш-линии (нет false sharing).
+ Блокирующие Push/Pop засыпают ТОЛЬКО когда очередь действительно полна/пуста: писатели на _notFull, читатели на _notEmpty, поэтому Push будит одного читателя, Pop - одного писателя (без лавины пробуждений).
+ */
+namespace LOCK_FREE
+{
+    template <typename T>
+    class ThreadSafeQueue
+    {
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+        
+        ThreadSafeQueue(const ThreadSafeQueue&) = delete;
+        ThreadSafeQueue& operator = (const ThreadSafeQueue&) = delete;
+        
+    public:
+        explicit ThreadSafeQueue(size_t capacity = 1024):
+        _mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+        _cells(std::make_unique<Cell[]>(_mask + 1))
+        {
+            for (size_t i = 0; i <= _mask; ++i)
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        
+        ~ThreadSafeQueue()
+        {
+            for (size_t pos = _dequeuePos.load(); pos != _enqueuePos.load(); ++pos)
+                std::destroy_at(Item(_cells[pos & _mask]));
+        }
+        
+        // Не блокирует поток: false - очередь полна, value не перемещается
+        bool TryPush(T&& value)
+        {
+            Cell* cell = nullptr;
+            size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &_cells[pos & _mask];
+                // LOAD (no) ↑ STORE (no)
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                // LOAD (no) ↓ STORE (yes)
+                intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+                if (diff == 0) // ячейка свободна, пытаемся занять позицию
+                {
+                    if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0) // читатель еще не освободил ячейку - очередь полна
+                    return false;
+                else // позицию занял другой писатель
+                    pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+            
+            new (cell->storage) T(std::move(value));
+            // LOAD (yes) ↑ STORE (no)
+            cell->sequence.store(pos + 1, std::memory_order_release); // публикация элемента читателю
+            // LOAD (no) ↓ STORE (no)
+            _notEmpty.NotifyOne(); // один элемент - один читатель
+            return true;
+        }
+        
+        // Не блокирует поток: false - очередь пуста
+        bool TryPop(T& value)
+        {
+            if (auto item = Dequeue())
+            {
+                value = std::move(*item);
+                return true;
+            }
+            return false;
+        }
+        
+        void Push(T&& value)
+        {
+            _notFull.Wait([&]() { return TryPush(std::move(value)); }); // value перемещается только при успехе
+        }
+        
+        T Pop()
+        {
+            std::optional<T> item;
+            _notEmpty.Wait([&]() { return (item = Dequeue()).has_value(); });
+            return std::move(*item);
+        }
+        
+        bool Empty() const noexcept
+        {
+            return _dequeuePos.load(std::memory_order_acquire) >= _enqueuePos.load(std::memory_order_acquire);
+        }
+        
+        size_t Capacity() const noexcept
+        {
+            return _mask + 1;
+        }
+        
+    private:
+        static T* Item(Cell& cell) noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(cell.storage));
+        }
+        
+        std::optional<T> Dequeue()
+        {
+            Cell* cell = nullptr;
+            size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &_cells[pos & _mask];
+                // LOAD (no) ↑ STORE (no)
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                // LOAD (no) ↓ STORE (yes)
+                intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+                if (diff == 0) // ячейка заполнена, пытаемся занять позицию
+                {
+                    if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0) // писатель еще не заполнил ячейку - очередь пуста
+                    return std::nullopt;
+                else // позицию занял другой читатель
+                    pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+            
+            T* item = Item(*cell);
+            std::optional<T> result(std::move(*item));
+            std::destroy_at(item);
+            // LOAD (yes) ↑ STORE (no)
+            cell->sequence.store(pos + _mask + 1, std::memory_order_release); // ячейка свободна для следующего круга писателей
+            // LOAD (no) ↓ STORE (no)
+            _notFull.NotifyOne(); // одна свободная ячейка - один писатель
+            return result;
+        }
+        
+    private:
+        const size_t _mask;
+        std::unique_ptr<Cell[]> _cells;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _enqueuePos = 0; // позиция писателей
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _dequeuePos = 0; // позиция читателей
+        alignas(CACHE_LINE_SIZE) Signal _notFull; // писатели ждут, когда очередь полна
+        alignas(CACHE_LINE_SIZE) Signal _notEmpty; // читатели ждут, когда очередь пуста
+    };
+}
+
+/*
+ Wait-free очередь SPSC (single-producer/single-consumer) - ограниченный кольцевой буфер для ровно 1 писателя и 1 читателя.
+ Писатель меняет только _tail, читатель - только _head, поэтому нет ни одной RMW операции (CAS, fetch_add) - только load(acquire)/store(release).
+ Каждая сторона кэширует индекс другой стороны (_cachedHead/_cachedTail) и перечитывает его только когда по кэшу очередь полна/пуста, поэтому кэш-линия чужого индекса почти не перемещается между ядрами.
+ Замечание: вызов Push из 2 потоков или Pop из 2 потоков - неопределенное поведение.
+ */
+namespace SPSC
+{
+    template <typename T>
+    class ThreadSafeQueue
+    {
+        struct Slot
+        {
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+        
+        ThreadSafeQueue(const ThreadSafeQueue&) = delete;
+        ThreadSafeQueue& operator = (const ThreadSafeQueue&) = delete;
+        
+    public:
+        explicit ThreadSafeQueue(size_t capacity = 1024):
+        _mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+        _slots(std::make_unique<Slot[]>(_mask + 1))
+        {
+        }
+        
+        ~ThreadSafeQueue()
+        {
+            for (size_t index = _head.load(); index != _tail.load(); ++index)
+                std::destroy_at(Item(index));
+        }
+        
+        // Только писатель. Не блокирует поток: false - очередь полна, value не перемещается
+        bool TryPush(T&& value)
+        {
+            const size_t tail = _tail.load(std::memory_order_relaxed); // свой индекс - читаем без барьера
+            if (tail - _cachedHead > _mask) // по кэшу очередь полна - перечитываем индекс читателя
+            {
+                // LOAD (no) ↑ STORE (no)
+                _cachedHead = _head.load(std::memory_order_acquire);
+                // LOAD (no) ↓ STORE (yes)
+                if (tail - _cachedHead > _mask)
+                    return false;
+            }
+            
+            new (_slots[tail & _mask].storage) T(std::move(value));
+            // LOAD (yes) ↑ STORE (no)
+            _tail.store(tail + 1, std::memory_order_release); // публикация элемента читателю
+            // LOAD (no) ↓ STORE (no)
+            return true;
+        }
+        
+        // Только читатель. Не блокирует поток: false - очередь пуста
+        bool TryPop(T& value)
+        {
+            if (T* item = Front())
+            {
+                value = std::move(*item);
+                PopFront();
+                return true;
+            }
+            return false;
+        }
+        
+        void Push(T&& value)
+        {
+            while (!TryPush(std::move(value))) // value перемещается только при успехе
+                std::this_thread::yield();
+        }
+        
+        T Pop()
+        {
+            T* item = nullptr;
+            while (!(item = Front()))
+                std::this_thread::yield();
+            
+            T result = std::move(*item);
+            PopFront();
+            return result;
+        }
+        
+        bool Empty() const noexcept
+        {
+            return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+        }
+        
+        size_t Capacity() const noexcept
+        {
+            return _mask + 1;
+        }
+        
+    private:
+        T* Item(size_t index) const noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(_slots[index & _mask].storage));
+        }
+        
+        T* Front() noexcept
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            if (head == _cachedTail) // по кэшу очередь пуста - перечитываем индекс писателя
+            {
+                // LOAD (no) ↑ STORE (no)
+                _cachedTail = _tail.load(std::memory_order_acquire);
+                // LOAD (no) ↓ STORE (yes)
+                if (head == _cachedTail)
+                    return nullptr;
+            }
+            return Item(head);
+        }
+        
+        void PopFront() noexcept
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            std::destroy_at(Item(head));
+            // LOAD (yes) ↑ STORE (no)
+            _head.store(head + 1, std::memory_order_release); // ячейка свободна для писателя
+            // LOAD (no) ↓ STORE (no)
+        }
+        
+    private:
+        const size_t _mask;
+        std::unique_ptr<Slot[]> _slots;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _head = 0; // индекс читателя
+        size_t _cachedTail = 0; // кэш индекса писателя, меняет только читатель
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail = 0; // индекс писателя
+        size_t _cachedHead = 0; // кэш индекса читателя, меняет только писатель
+    };
+}
+
+/*
+ Очередь с 2 блокировками (Michael-Scott two-lock queue) - неограниченный односвязный список с фиктивным (dummy) узлом.
+ Писатели добавляют в хвост под _tailMutex, читатели удаляют из головы под _headMutex, поэтому писатель конкурирует только с писателями, а читатель - только с читателями.
+ Фиктивный узел: _head всегда указывает на узел без значения, первый элемент - _head->next. Поэтому даже в пустой очереди _head и _tail не меняются одновременно.
+ Если очередь пуста, то Pop ждет на Signal, а не на condition_variable - писателю не нужен _headMutex для уведомления.
+ */
+namespace TWO_LOCK
+{
+    template <typename T>
+    class ThreadSafeQueue
+    {
+        struct Node
+        {
+            std::optional<T> value; // у фиктивного узла значения нет
+            std::atomic<Node*> next = nullptr; // писатель пишет под _tailMutex, читатель читает под _headMutex
+        };
+        
+        ThreadSafeQueue(const ThreadSafeQueue&) = delete;
+        ThreadSafeQueue& operator = (const ThreadSafeQueue&) = delete;
+        
+    public:
+        ThreadSafeQueue():
+        _head(new Node),
+        _tail(_head)
+        {
+        }
+        
+        ~ThreadSafeQueue()
+        {
+            while (_head)
+                delete std::exchange(_head, _head->next.load());
+        }
+        
+        void Push(T&& value)
+        {
+            Node* node = new Node{std::optional<T>(std::move(value))}; // память выделяется без блокировки
+            {
+                std::lock_guard lock(_tailMutex);
+                // LOAD (yes) ↑ STORE (no)
+                _tail->next.store(node, std::memory_order_release); // публикация узла читателю
+                // LOAD (no) ↓ STORE (no)
+                _tail = node;
+            }
+            _signal.NotifyOne();
+        }
+        
+        // Не блокирует поток: false - очередь пуста
+        bool TryPop(T& value)
+        {
+            if (auto item = Dequeue())
+            {
+                value = std::move(*item);
+                return true;
+            }
+            return false;
+        }
+        
+        T Pop()
+        {
+            std::optional<T> item;
+            _signal.Wait([&]() { return (item = Dequeue()).has_value(); });
+            return std::move(*item);
+        }
+        
+        bool Empty()
+        {
+            std::lock_guard lock(_headMutex);
+            return _head->next.load(std::memory_order_acquire) == nullptr;
+        }
+        
+    private:
+        std::optional<T> Dequeue()
+        {
+            std::unique_ptr<Node> dummy; // старый фиктивный узел удаляется после разблокировки
+            std::optional<T> item;
+            {
+                std::lock_guard lock(_headMutex);
+                // LOAD (no) ↑ STORE (no)
+                Node* next = _head->next.load(std::memory_order_acquire);
+                // LOAD (no) ↓ STORE (yes)
+                if (!next)
+                    return std::nullopt;
+                
+                item = std::move(next->value);
+                next->value.reset(); // next становится новым фиктивным узлом
+                dummy.reset(std::exchange(_head, next));
+            }
+            return item;
+        }
+        
+    private:
+        alignas(CACHE_LINE_SIZE) std::mutex _headMutex;
+        Node* _head;
+        alignas(CACHE_LINE_SIZE) std::mutex _tailMutex;
+        Node* _tail;
+        alignas(CACHE_LINE_SIZE) Signal _signal;
+    };
+}
+
+/*
+ Очередь без выделения памяти - все узлы заранее выделяются в пуле (_nodes) фиксированного размера в конструкторе.
+ std::queue (std::deque) постоянно выделяет и освобождает блоки памяти при движении очереди, здесь же узлы только переходят из списка свободных (_free) в очередь и обратно.
+ Элементы только перемещаются (подходят move-only типы, например std::unique_ptr), после прогрева нет ни одного выделения памяти в куче.
+ Если свободных узлов нет (очередь полна), то Push ждет, пока Pop не вернет узел в пул.
+ */
+namespace POOL
+{
+    template <typename T>
+    class ThreadSafeQueue
+    {
+        struct Node
+        {
+            alignas(T) unsigned char storage[sizeof(T)];
+            Node* next = nullptr;
+        };
+        
+        ThreadSafeQueue(const ThreadSafeQueue&) = delete;
+        ThreadSafeQueue& operator = (const ThreadSafeQueue&) = delete;
+        
+    public:
+        explicit ThreadSafeQueue(size_t capacity = 1024):
+        _nodes(std::max<size_t>(capacity, 1))
+        {
+            for (auto& node : _nodes)
+                node.next = std::exchange(_free, &node);
+        }
+        
+        ~ThreadSafeQueue()
+        {
+            for (Node* node = _head; node; node = node->next)
+                std::destroy_at(Item(node));
+        }
+        
+        void Push(T&& value)
+        {
+            std::unique_lock lock(_mutex);
+            _notFull.wait(lock, [this]() { return _free != nullptr; }); // если пул пуст, то ждем
+            new (_free->storage) T(std::move(value)); // сначала конструирование: если конструктор T бросит исключение, узел останется в пуле
+            Node* node = std::exchange(_free, _free->next);
+            node->next = nullptr;
+            (_tail ? _tail->next : _head) = node;
+            _tail = node;
+            lock.unlock();
+            _notEmpty.notify_one(); // Уведомить один ожидающий поток, что он может удалить элемент
+        }
+        
+        T Pop()
+        {
+            std::unique_lock lock(_mutex);
+            _notEmpty.wait(lock, [this]() { return _head != nullptr; }); // если очередь пуста, то ждем
+            T result = Take();
+            lock.unlock();
+            _notFull.notify_one(); // Уведомить один ожидающий писатель, что появился свободный узел
+            return result;
+        }
+        
+        // Не блокирует поток: false - очередь пуста
+        bool TryPop(T& value)
+        {
+            std::unique_lock lock(_mutex);
+            if (!_head)
+                return false;
+            
+            value = Take();
+            lock.unlock();
+            _notFull.notify_one();
+            return true;
+        }
+        
+        bool Empty()
+        {
+            std::lock_guard lock(_mutex);
+            return _head == nullptr;
+        }
+        
+        size_t Capacity() const noexcept
+        {
+            return _nodes.size();
+        }
+        
+    private:
+        static T* Item(Node* node) noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(node->storage));
+        }
+        
+        // Вызывается под _mutex, очередь не пуста
+        T Take()
+        {
+            Node* node = std::exchange(_head, _head->next);
+            if (!_head)
+                _tail = nullptr;
+            
+            T* item = Item(node);
+            T result = std::move(*item);
+            std::destroy_at(item);
+            node->next = std::exchange(_free, node); // узел возвращается в пул
+            return result;
+        }
+        
+    private:
+        std::vector<Node> _nodes; // пул узлов - выделяется один раз в конструкторе
+        Node* _free = nullptr; // список свободных узлов
+        Node* _head = nullptr;
+        Node* _tail = nullptr;
+        std::mutex _mutex;
+        std::condition_variable _notEmpty;
+        std::condition_variable _notFull;
+    };
+}
 
+/*
+ Очередь с ожиданием в стиле futex - данные защищены mutex, но Pop ждет не на condition_variable, а на Signal (std::atomic::wait/notify_one).
+ Отличие от MUTEX::ThreadSafeQueue:
+ - condition_variable после каждого пробуждения заново захватывает mutex, здесь читатель сначала крутится (spin) на атомарном счетчике _size без блокировки и берет mutex, только когда элемент точно есть.
+ - Push делает notify (системный вызов) только если есть спящий читатель, поэтому при "горячих" читателях почти ни один Push не уходит в ядро.
+ */
+namespace FUTEX
+{
+    template <typename T>
+    class ThreadSafeQueue
+    {
+    public:
+        void Push(T&& value)
+        {
+            {
+                std::lock_guard lock(_mutex);
+                _queue.push(std::move(value));
+                _size.store(_queue.size(), std::memory_order_release);
+            }
+            _signal.NotifyOne(); // системный вызов только при наличии спящих читателей
+        }
+        
+        // Не блокирует поток: false - очередь пуста
+        bool TryPop(T& value)
+        {
+            if (auto item = Dequeue())
+            {
+                value = std::move(*item);
+                return true;
+            }
+            return false;
+        }
+        
+        T Pop()
+        {
+            std::optional<T> item;
+            _signal.Wait([&]() { return (item = Dequeue()).has_value(); });
+            return std::move(*item);
+        }
+        
+        bool Empty() const noexcept
+        {
+            return _size.load(std::memory_order_acquire) == 0;
+        }
+        
+    private:
+        std::optional<T> Dequeue()
+        {
+            if (_size.load(std::memory_order_acquire) == 0) // проверка без блокировки
+                return std::nullopt;
+            
+            std::lock_guard lock(_mutex);
+            if (_queue.empty()) // элемент успел забрать другой читатель
+                return std::nullopt;
+            
+            std::optional<T> item(std::move(_queue.front()));
+            _queue.pop();
+            _size.store(_queue.size(), std::memory_order_release);
+            return item;
+        }
+        
     private:
         std::queue<T> _queue;
-        std::shared_mutex _mutex;
+        std::mutex _mutex;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _size = 0; // размер очереди для проверки без блокировки
+        alignas(CACHE_LINE_SIZE) Signal _signal;
+    };
+}
+
+/*
+ Шардированная очередь (sharded queue) с перехватом работы (work stealing) - вместо одной очереди по подочереди (шарду) на каждый аппаратный поток (std::thread::hardware_concurrency).
+ - писатель добавляет элемент в свой шард (по номеру потока), поэтому писатели разных потоков не конкурируют за один mutex и одну кэш-линию.
+ - читатель сначала берет элемент из своего шарда, если он пуст - перехватывает (steal) из шарда случайной жертвы.
+ Каждый шард выровнен по кэш-линии, пустые шарды пропускаются по атомарному размеру без захвата mutex.
+ Замечание: порядок FIFO соблюдается только внутри шарда, а не для всей очереди.
+ */
+namespace SHARDED
+{
+    template <typename T>
+    class ThreadSafeQueue
+    {
+        struct alignas(CACHE_LINE_SIZE) Shard
+        {
+            std::mutex mutex;
+            std::deque<T> queue;
+            std::atomic<size_t> size = 0; // размер для проверки без блокировки
+        };
+        
+        ThreadSafeQueue(const ThreadSafeQueue&) = delete;
+        ThreadSafeQueue& operator = (const ThreadSafeQueue&) = delete;
+        
+    public:
+        explicit ThreadSafeQueue(size_t shards = std::thread::hardware_concurrency()):
+        _shards(std::max<size_t>(shards, 1))
+        {
+        }
+        
+        void Push(T&& value)
+        {
+            Shard& shard = _shards[ThreadIndex() % _shards.size()];
+            {
+                std::lock_guard lock(shard.mutex);
+                shard.queue.push_back(std::move(value));
+                shard.size.store(shard.queue.size(), std::memory_order_release);
+            }
+            _signal.NotifyOne();
+        }
+        
+        // Не блокирует поток: false - все шарды пусты
+        bool TryPop(T& value)
+        {
+            if (auto item = Dequeue())
+            {
+                value = std::move(*item);
+                return true;
+            }
+            return false;
+        }
+        
+        T Pop()
+        {
+            std::optional<T> item;
+            _signal.Wait([&]() { return (item = Dequeue()).has_value(); });
+            return std::move(*item);
+        }
+        
+        bool Empty() const noexcept
+        {
+            return std::all_of(_shards.begin(), _shards.end(), [](const Shard& shard) { return shard.size.load(std::memory_order_acquire) == 0; });
+        }
+        
+        size_t Shards() const noexcept
+        {
+            return _shards.size();
+        }
+        
+    private:
+        static std::optional<T> Dequeue(Shard& shard)
+        {
+            if (shard.size.load(std::memory_order_acquire) == 0) // проверка без блокировки
+                return std::nullopt;
+            
+            std::lock_guard lock(shard.mutex);
+            if (shard.queue.empty()) // элемент успел забрать другой читатель
+                return std::nullopt;
+            
+            std::optional<T> item(std::move(shard.queue.front()));
+            shard.queue.pop_front();
+            shard.size.store(shard.queue.size(), std::memory_order_release);
+            return item;
+        }
+        
+        std::optional<T> Dequeue()
+        {
+            const size_t local = ThreadIndex() % _shards.size();
+            if (auto item = Dequeue(_shards[local])) // 1. свой шард
+                return item;
+            
+            // 2. work stealing: обход всех шардов, начиная со случайной жертвы
+            thread_local std::minstd_rand random(static_cast<unsigned>(ThreadIndex() + 1));
+            const size_t victim = random() % _shards.size();
+            for (size_t i = 0; i < _shards.size(); ++i)
+            {
+                const size_t index = (victim + i) % _shards.size();
+                if (index == local)
+                    continue;
+                if (auto item = Dequeue(_shards[index]))
+                    return item;
+            }
+            return std::nullopt;
+        }
+        
+    private:
+        std::vector<Shard> _shards;
+        alignas(CACHE_LINE_SIZE) Signal _signal;
+    };
+}
+
+/*
+ Конкурентная очередь с приоритетом (relaxed MultiQueue) - вместо одного mutex вокруг std::priority_queue несколько куч (heap), у каждой свой mutex, их в 2 раза больше, чем аппаратных потоков.
+ - Push кладет элемент в случайную кучу, занятую кучу (try_lock не удался) пропускает и берет другую.
+ - Pop выбирает 2 случайные кучи и берет элемент из той, у которой выше приоритет вершины (приоритет вершины читается атомарно без блокировки).
+ Порядок ослабленный (relaxed): Pop возвращает один из самых приоритетных элементов, но не обязательно самый приоритетный. Срочное сообщение все равно обгоняет тысячи обычных, а потоки почти не конкурируют за блокировки.
+ Если 2 случайные кучи пусты, то Pop обходит все кучи, поэтому элемент никогда не теряется. Если очередь пуста, то Pop ждет на Signal.
+ */
+namespace PRIORITY
+{
+    template <typename T, typename TPriority = int>
+    class ThreadSafeQueue
+    {
+        // Приоритет вершины кучи читается без блокировки (std::atomic<TPriority>), поэтому TPriority - тривиально копируемый и не шире lock-free атомарной операции (иначе std::atomic внутри использует скрытую блокировку)
+        static_assert(std::is_trivially_copyable_v<TPriority>, "PRIORITY::ThreadSafeQueue<T, TPriority>: TPriority должен быть тривиально копируемым");
+        static_assert(std::atomic<TPriority>::is_always_lock_free, "PRIORITY::ThreadSafeQueue<T, TPriority>: std::atomic<TPriority> должен быть lock-free");
+        
+        using Item = std::pair<TPriority, T>;
+        
+        struct alignas(CACHE_LINE_SIZE) Heap
+        {
+            std::mutex mutex;
+            std::vector<Item> items; // max-heap по приоритету
+            std::atomic<size_t> size = 0;
+            std::atomic<TPriority> top = TPriority(); // приоритет вершины, действителен при size > 0
+        };
+        
+        ThreadSafeQueue(const ThreadSafeQueue&) = delete;
+        ThreadSafeQueue& operator = (const ThreadSafeQueue&) = delete;
+        
+    public:
+        explicit ThreadSafeQueue(size_t heaps = 2 * std::thread::hardware_concurrency()):
+        _heaps(std::max<size_t>(heaps, 2))
+        {
+        }
+        
+        void Push(TPriority priority, T&& value)
+        {
+            for (;;)
+            {
+                Heap& heap = _heaps[Random() % _heaps.size()];
+                std::unique_lock lock(heap.mutex, std::try_to_lock);
+                if (!lock) // куча занята другим потоком - берем другую
+                    continue;
+                
+                heap.items.emplace_back(priority, std::move(value));
+                std::push_heap(heap.items.begin(), heap.items.end(), Less);
+                Update(heap);
+                break;
+            }
+            _signal.NotifyOne();
+        }
+        
+        // Не блокирует поток: false - очередь пуста
+        bool TryPop(T& value)
+        {
+            if (auto item = Dequeue())
+            {
+                value = std::move(*item);
+                return true;
+            }
+            return false;
+        }
+        
+        T Pop()
+        {
+            std::optional<T> item;
+            _signal.Wait([&]() { return (item = Dequeue()).has_value(); });
+            return std::move(*item);
+        }
+        
+        bool Empty() const noexcept
+        {
+            return std::all_of(_heaps.begin(), _heaps.end(), [](const Heap& heap) { return heap.size.load(std::memory_order_acquire) == 0; });
+        }
+        
+    private:
+        static bool Less(const Item& lhs, const Item& rhs) noexcept
+        {
+            return lhs.first < rhs.first;
+        }
+        
+        static size_t Random() noexcept
+        {
+            static std::atomic<unsigned> seed = 0;
+            thread_local std::minstd_rand random(seed.fetch_add(1, std::memory_order_relaxed) + 1);
+            return random();
+        }
+        
+        // Вызывается под mutex кучи
+        static void Update(Heap& heap) noexcept
+        {
+            if (!heap.items.empty())
+                heap.top.store(heap.items.front().first, std::memory_order_relaxed);
+            heap.size.store(heap.items.size(), std::memory_order_release);
+        }
+        
+        // Лучшая из 2 куч: непустая и с более приоритетной вершиной
+        Heap* Best(Heap* lhs, Heap* rhs) const noexcept
+        {
+            if (lhs->size.load(std::memory_order_acquire) == 0)
+                return rhs->size.load(std::memory_order_acquire) == 0 ? nullptr : rhs;
+            if (rhs->size.load(std::memory_order_acquire) == 0)
+                return lhs;
+            return lhs->top.load(std::memory_order_relaxed) < rhs->top.load(std::memory_order_relaxed) ? rhs : lhs;
+        }
+        
+        static std::optional<T> Dequeue(Heap& heap, bool wait)
+        {
+            std::unique_lock lock(heap.mutex, std::defer_lock);
+            if (wait)
+                lock.lock();
+            else if (!lock.try_lock())
+                return std::nullopt;
+            
+            if (heap.items.empty()) // элемент успел забрать другой читатель
+                return std::nullopt;
+            
+            std::pop_heap(heap.items.begin(), heap.items.end(), Less);
+            std::optional<T> item(std::move(heap.items.back().second));
+            heap.items.pop_back();
+            Update(heap);
+            return item;
+        }
+        
+        std::optional<T> Dequeue()
+        {
+            // 1. Выбор лучшей из 2 случайных куч
+            for (size_t attempt = 0; attempt < _heaps.size(); ++attempt)
+            {
+                Heap* heap = Best(&_heaps[Random() % _heaps.size()], &_heaps[Random() % _heaps.size()]);
+                if (!heap)
+                    break;
+                if (auto item = Dequeue(*heap, false))
+                    return item;
+            }
+            
+            // 2. Обход всех куч: элемент есть хотя бы в одной непустой куче
+            for (;;)
+            {
+                Heap* best = nullptr;
+                for (auto& heap : _heaps)
+                    best = best ? Best(best, &heap) : (heap.size.load(std::memory_order_acquire) ? &heap : nullptr);
+                if (!best)
+                    return std::nullopt;
+                if (auto item = Dequeue(*best, true))
+                    return item;
+            }
+        }
+        
+    private:
+        std::vector<Heap> _heaps;
+        alignas(CACHE_LINE_SIZE) Signal _signal;
+    };
+}
+
+/*
+ Lock-free очередь Майкла-Скотта (Michael-Scott) без ограничения размера: в отличии от TWO_LOCK вместо mutex - compare_exchange над _head/_tail.
+ Освобождение узлов - hazard pointers (HazardPointer.h): узел, который прочитал другой поток, не будет освобожден, а кол-во неосвобожденных узлов ограничено даже при остановившемся читателе.
+ 1. Push: узел добавляется compare_exchange в next последнего узла, затем _tail передвигается на него (если поток не успел, то _tail передвинет другой поток).
+ 2. Pop: _head передвигается compare_exchange на следующий узел, старый фиктивный узел откладывается (HP::Retire).
+ */
+namespace HAZARD_POINTER
+{
+    template <typename T>
+    class ThreadSafeQueue
+    {
+        struct Node
+        {
+            std::optional<T> value; // у фиктивного узла значения нет
+            std::atomic<Node*> next = nullptr;
+        };
+        
+        ThreadSafeQueue(const ThreadSafeQueue&) = delete;
+        ThreadSafeQueue& operator = (const ThreadSafeQueue&) = delete;
+        
+    public:
+        ThreadSafeQueue():
+        _head(new Node),
+        _tail(_head.load())
+        {
+        }
+        
+        ~ThreadSafeQueue()
+        {
+            Node* node = _head.load();
+            while (node)
+                delete std::exchange(node, node->next.load());
+        }
+        
+        void Push(T&& value)
+        {
+            Node* node = new Node{std::optional<T>(std::move(value))};
+            HP::HazardPointer hazard;
+            while (true)
+            {
+                Node* tail = hazard.Protect(_tail);
+                Node* next = tail->next.load(std::memory_order_acquire);
+                if (next) // _tail отстал: помогаем передвинуть
+                {
+                    _tail.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+                    continue;
+                }
+                
+                Node* expected = nullptr;
+                // LOAD (yes) ↑ STORE (no)
+                if (tail->next.compare_exchange_weak(expected, node, std::memory_order_release, std::memory_order_relaxed)) // публикация узла
+                // LOAD (no) ↓ STORE (no)
+                {
+                    _tail.compare_exchange_strong(tail, node, std::memory_order_release, std::memory_order_relaxed);
+                    break;
+                }
+            }
+            _signal.NotifyOne();
+        }
+        
+        // Не блокирует поток: false - очередь пуста
+        bool TryPop(T& value)
+        {
+            if (auto item = Dequeue())
+            {
+                value = std::move(*item);
+                return true;
+            }
+            return false;
+        }
+        
+        T Pop()
+        {
+            std::optional<T> item;
+            _signal.Wait([&]() { return (item = Dequeue()).has_value(); });
+            return std::move(*item);
+        }
+        
+        bool Empty()
+        {
+            HP::HazardPointer hazard;
+            return hazard.Protect(_head)->next.load(std::memory_order_acquire) == nullptr;
+        }
+        
+    private:
+        std::optional<T> Dequeue()
+        {
+            HP::HazardPointer headHazard, nextHazard;
+            while (true)
+            {
+                Node* head = headHazard.Protect(_head);
+                Node* next = nextHazard.Protect(head->next); // head защищен, поэтому head->next можно читать
+                if (head != _head.load(std::memory_order_acquire)) // head уже удален: next мог быть освобожден до защиты
+                    continue;
+                if (!next)
+                    return std::nullopt;
+                
+                Node* tail = _tail.load(std::memory_order_acquire);
+                if (head == tail) // _tail отстал: помогаем передвинуть, иначе _tail укажет на освобожденный узел
+                {
+                    _tail.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+                    continue;
+                }
+                
+                // acq_rel: next был опубликован писателем (release), другой читатель получит его через _head
+                // LOAD (no) ↑ STORE (no)
+                if (_head.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_relaxed))
+                // LOAD (no) ↓ STORE (no)
+                {
+                    std::optional<T> item = std::move(next->value); // next - новый фиктивный узел, его значение читает только этот поток
+                    headHazard.Reset();
+                    HP::Retire(head);
+                    return item;
+                }
+            }
+        }
+        
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<Node*> _head;
+        alignas(CACHE_LINE_SIZE) std::atomic<Node*> _tail;
+        alignas(CACHE_LINE_SIZE) Signal _signal;
     };
 }
 
@@ -0,0 +1,116 @@
+#ifndef SeqLock_h
+#define SeqLock_h
+
+#include "CacheLine.h"
+#include "Spinlock.h"
+
+#include <array>
+#include <bit>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+
+/*
+ SeqLock (sequence lock) - блокировка для часто читаемых и редко изменяемых небольших структур (конфигурация, котировка), для которых std::atomic<T> не lock-free (размер > 8/16 байт) и внутри использует скрытую глобальную блокировку.
+ Принцип работы: счетчик версий _sequence - четный: данные согласованы, нечетный: идет запись.
+ 1. Store (писатель): _sequence + 1 (нечетный) -> запись данных -> _sequence + 1 (четный).
+ 2. Load (читатель): читает _sequence -> копирует данные -> снова читает _sequence. Если _sequence нечетный или изменился, то чтение попало на запись (разорванное чтение, torn read) - повтор.
+ Свойства:
+ - читатели ничего не записывают в общую память: чтение не перебрасывает кэш-линии между ядрами читателей и не мешает писателю (в отличии от std::shared_mutex, где каждый захват на чтение - запись счетчика читателей).
+ - писатель никогда не ждет читателей, читатель повторяет чтение только при одновременной записи.
+ - один писатель: Store из нескольких потоков нужно защищать внешней блокировкой.
+ - T - тривиально копируемый тип (копирование побайтово), конструктор по умолчанию нужен только для SeqLock().
+ Замечание: одновременные запись и чтение обычной памяти - гонка данных (data race) и неопределенное поведение в C++, поэтому данные хранятся в словах std::atomic<uint64_t> и копируются relaxed операциями (на x86/ARM это обычные mov/ldr).
+ */
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock<T>: T должен быть тривиально копируемым");
+    
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+    
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    
+    using Words = std::array<uint64_t, WORDS>;
+    
+public:
+    SeqLock() noexcept : SeqLock(T{}) {}
+    explicit SeqLock(const T& value) noexcept
+    {
+        Write(value);
+    }
+    ~SeqLock() = default;
+    
+    // Только один писатель
+    void Store(const T& value) noexcept
+    {
+        const uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed); // нечетный: идет запись
+        // STORE данных не поднимается выше нечетного _sequence
+        std::atomic_thread_fence(std::memory_order_release);
+        Write(value);
+        // LOAD (yes) ↑ STORE (no)
+        _sequence.store(sequence + 2, std::memory_order_release); // четный: данные согласованы
+        // LOAD (no) ↓ STORE (no)
+    }
+    
+    T Load() const noexcept
+    {
+        Words words;
+        while (!TryRead(words))
+            CpuPause();
+        return FromWords(words);
+    }
+    
+    // Одна попытка чтения: false - чтение попало на запись, value не изменяется
+    bool TryLoad(T& value) const noexcept
+    {
+        Words words;
+        if (!TryRead(words))
+            return false;
+        
+        value = FromWords(words);
+        return true;
+    }
+    
+private:
+    void Write(const T& value) noexcept
+    {
+        Words words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+        for (size_t i = 0; i < WORDS; ++i)
+            _data[i].store(words[i], std::memory_order_relaxed);
+    }
+    
+    bool TryRead(Words& words) const noexcept
+    {
+        // LOAD (no) ↑ STORE (no)
+        const uint32_t before = _sequence.load(std::memory_order_acquire);
+        // LOAD (no) ↓ STORE (yes)
+        if (before & 1)
+            return false;
+        
+        for (size_t i = 0; i < WORDS; ++i)
+            words[i] = _data[i].load(std::memory_order_relaxed);
+        // LOAD данных не опускается ниже повторного чтения _sequence
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return _sequence.load(std::memory_order_relaxed) == before;
+    }
+    
+    // Через байты и std::bit_cast: T не обязан иметь конструктор по умолчанию (T тривиально копируемый)
+    static T FromWords(const Words& words) noexcept
+    {
+        std::array<unsigned char, sizeof(T)> bytes;
+        std::memcpy(bytes.data(), words.data(), sizeof(T));
+        return std::bit_cast<T>(bytes);
+    }
+    
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> _sequence = 0;
+    std::array<std::atomic<uint64_t>, WORDS> _data;
+};
+
+#endif /* SeqLock_h */
@@ -0,0 +1,329 @@
+#ifndef SharedMutex_h
+#define SharedMutex_h
+
+#include "CacheLine.h"
+#include "Spinlock.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+
+/*
+ Блокировки чтения/записи (readers-writer lock) - замена std::shared_mutex, совместимы с std::unique_lock/std::shared_lock.
+ */
+
+/*
+ Big-reader lock (brlock) - блокировка чтения/записи для данных, которые почти только читают.
+ Проблема std::shared_mutex: каждый lock_shared/unlock_shared - атомарная операция (RMW) над ОДНИМ общим счетчиком читателей, поэтому все читатели отбирают друг у друга одну кэш-линию и чтение перестает масштабироваться с ростом кол-ва ядер.
+ Решение: у каждого потока свой счетчик читателей (индикатор) в своей кэш-линии (Padded):
+ - lock_shared - поток увеличивает СВОЙ счетчик и проверяет флаг писателя. Запись только в свою кэш-линию, общая кэш-линия флага только читается (остается в кэше ядра в состоянии Shared).
+ - lock - писатель захватывает флаг _writer (новые читатели отступают), затем обходит все счетчики читателей и ждет, пока они обнулятся.
+ Цена: запись дороже - обход SLOTS кэш-линий, поэтому подходит, когда записей намного меньше, чем чтений.
+ Замечание:
+ - вместо номера ядра используется номер потока (ThreadIndex), т.к. номер ядра можно получить не на всех платформах, а поток может сменить ядро между lock_shared и unlock_shared. Потоки с одинаковым ThreadIndex() % SLOTS делят счетчик (корректно, но с конкуренцией).
+ - приоритет писателей: пока писатель ждет, новые читатели не входят, поэтому повторный lock_shared в том же потоке может привести к взаимной блокировке (как и у std::shared_mutex).
+ */
+namespace BIG_READER
+{
+    class shared_mutex
+    {
+        shared_mutex(const shared_mutex&) = delete;
+        shared_mutex& operator=(const shared_mutex&) = delete;
+
+    public:
+        static constexpr size_t SLOTS = 64; // счетчики читателей
+
+    public:
+        shared_mutex() = default;
+
+        void lock() noexcept
+        {
+            // Захват флага писателя: писатели ждут друг друга через atomic wait
+            while (_writer.exchange(true, std::memory_order_seq_cst))
+                _writer.wait(true, std::memory_order_relaxed);
+
+            // Флаг виден всем новым читателям, ждем выхода текущих читателей
+            for (auto& readers : _readers)
+            {
+                Backoff backoff;
+                while (readers->load(std::memory_order_seq_cst) != 0)
+                    backoff.Pause();
+            }
+            // LOAD (no) ↓ STORE (no)
+        }
+
+        bool try_lock() noexcept
+        {
+            if (_writer.load(std::memory_order_relaxed) || _writer.exchange(true, std::memory_order_seq_cst))
+                return false;
+
+            for (auto& readers : _readers)
+            {
+                if (readers->load(std::memory_order_seq_cst) != 0)
+                {
+                    unlock();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void unlock() noexcept
+        {
+            // LOAD (yes) ↑ STORE (yes)
+            _writer.store(false, std::memory_order_release);
+            _writer.notify_all();
+        }
+
+        void lock_shared() noexcept
+        {
+            std::atomic<uint32_t>& readers = Readers();
+            while (true)
+            {
+                // seq_cst: увеличение счетчика не опускается ниже чтения флага (STORE -> LOAD), иначе писатель и читатель не увидят друг друга
+                readers.fetch_add(1, std::memory_order_seq_cst);
+                if (!_writer.load(std::memory_order_seq_cst))
+                    return;
+                // LOAD (no) ↓ STORE (no)
+
+                // Писатель активен или ждет - отступаем, чтобы он не ждал нас
+                readers.fetch_sub(1, std::memory_order_release);
+                _writer.wait(true, std::memory_order_relaxed);
+            }
+        }
+
+        bool try_lock_shared() noexcept
+        {
+            std::atomic<uint32_t>& readers = Readers();
+            readers.fetch_add(1, std::memory_order_seq_cst);
+            if (!_writer.load(std::memory_order_seq_cst))
+                return true;
+
+            readers.fetch_sub(1, std::memory_order_release);
+            return false;
+        }
+
+        void unlock_shared() noexcept
+        {
+            // LOAD (yes) ↑ STORE (no)
+            Readers().fetch_sub(1, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<uint32_t>& Readers() noexcept
+        {
+            return *_readers[ThreadIndex() % SLOTS];
+        }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<bool> _writer = false; // писатель активен или ждет читателей
+        std::array<Padded<std::atomic<uint32_t>>, SLOTS> _readers{};
+    };
+}
+
+/*
+ Политика блокировки чтения/записи - кто проходит первым, когда ждут и читатели, и писатели:
+ - READER_PREFERRING - приоритет читателей: читатель входит, если нет активного писателя. Максимальная пропускная способность чтения, но непрерывный поток читателей морит голодом писателя (так ведет себя std::shared_mutex в glibc).
+ - WRITER_PREFERRING - приоритет писателей: пока писатель ждет, новые читатели не входят. Писатель ждет только текущих читателей, но непрерывный поток писателей морит голодом читателей.
+ - PHASE_FAIR - фазы чтения и записи чередуются: пока писатель ждет, новые читатели не входят, а при освобождении записи входят ВСЕ ожидающие читатели разом (фаза чтения), даже если ждут другие писатели.
+   Писатель ждет не больше одной фазы чтения и очереди писателей, читатель - не больше одной фазы записи.
+ */
+enum class RWPolicy
+{
+    READER_PREFERRING,
+    WRITER_PREFERRING,
+    PHASE_FAIR
+};
+
+// Время ожидания захвата: acquisitions - все захваты, blocked - захваты с ожиданием, total/max - время ожидания
+struct RWWaitTime
+{
+    uint64_t acquisitions = 0;
+    uint64_t blocked = 0;
+    std::chrono::nanoseconds total{ 0 };
+    std::chrono::nanoseconds max{ 0 };
+
+    // Среднее время ожидания одного захвата
+    std::chrono::nanoseconds Average() const noexcept
+    {
+        return acquisitions ? total / int64_t(acquisitions) : std::chrono::nanoseconds(0);
+    }
+};
+
+struct RWWaitStatistics
+{
+    RWWaitTime readers;
+    RWWaitTime writers;
+};
+
+/*
+ Блокировка чтения/записи с политикой Policy на std::mutex + std::condition_variable, ожидающие потоки засыпают.
+ Статистика ожидания (Statistics) собирается под внутренним мьютексом, время замеряется только при ожидании, поэтому захват без ожидания не вызывает часы.
+ */
+namespace RW_POLICY
+{
+    template <RWPolicy Policy>
+    class shared_mutex
+    {
+        using Clock = std::chrono::steady_clock;
+
+        shared_mutex(const shared_mutex&) = delete;
+        shared_mutex& operator=(const shared_mutex&) = delete;
+
+    public:
+        static constexpr RWPolicy POLICY = Policy;
+
+    public:
+        shared_mutex() = default;
+
+        void lock()
+        {
+            std::unique_lock lock(_mutex);
+            ++_statistics.writers.acquisitions;
+            if (_writer || _readers > 0)
+            {
+                const auto start = Clock::now();
+                ++_waitingWriters;
+                _writerCv.wait(lock, [this]() { return !_writer && _readers == 0; });
+                --_waitingWriters;
+                Record(_statistics.writers, Clock::now() - start);
+            }
+            _writer = true;
+        }
+
+        bool try_lock()
+        {
+            std::lock_guard lock(_mutex);
+            if (_writer || _readers > 0)
+                return false;
+
+            ++_statistics.writers.acquisitions;
+            _writer = true;
+            return true;
+        }
+
+        void unlock()
+        {
+            std::lock_guard lock(_mutex);
+            _writer = false;
+            if constexpr (Policy == RWPolicy::READER_PREFERRING)
+            {
+                _readerCv.notify_all();
+                if (_waitingWriters > 0)
+                    _writerCv.notify_one();
+            }
+            else if constexpr (Policy == RWPolicy::WRITER_PREFERRING)
+            {
+                if (_waitingWriters > 0)
+                    _writerCv.notify_one();
+                else
+                    _readerCv.notify_all();
+            }
+            else
+            {
+                if (_waitingReaders > 0) // Фаза чтения: все ожидающие читатели входят разом, следующий писатель ждет их выхода
+                {
+                    _readers += _waitingReaders;
+                    _waitingReaders = 0;
+                    ++_phase;
+                    _readerCv.notify_all();
+                }
+                else if (_waitingWriters > 0)
+                {
+                    _writerCv.notify_one();
+                }
+            }
+        }
+
+        void lock_shared()
+        {
+            std::unique_lock lock(_mutex);
+            ++_statistics.readers.acquisitions;
+            if (!ReaderMustWait())
+            {
+                ++_readers;
+                return;
+            }
+
+            const auto start = Clock::now();
+            if constexpr (Policy == RWPolicy::PHASE_FAIR)
+            {
+                // Читатель уже учтен в _readers писателем, который начал фазу чтения
+                ++_waitingReaders;
+                const uint64_t phase = _phase;
+                _readerCv.wait(lock, [this, phase]() { return _phase != phase; });
+            }
+            else
+            {
+                _readerCv.wait(lock, [this]() { return !ReaderMustWait(); });
+                ++_readers;
+            }
+            Record(_statistics.readers, Clock::now() - start);
+        }
+
+        bool try_lock_shared()
+        {
+            std::lock_guard lock(_mutex);
+            if (ReaderMustWait())
+                return false;
+
+            ++_statistics.readers.acquisitions;
+            ++_readers;
+            return true;
+        }
+
+        void unlock_shared()
+        {
+            std::lock_guard lock(_mutex);
+            if (--_readers == 0 && _waitingWriters > 0)
+                _writerCv.notify_one();
+        }
+
+        RWWaitStatistics Statistics() const
+        {
+            std::lock_guard lock(_mutex);
+            return _statistics;
+        }
+
+        void ResetStatistics()
+        {
+            std::lock_guard lock(_mutex);
+            _statistics = {};
+        }
+
+    private:
+        bool ReaderMustWait() const noexcept
+        {
+            if constexpr (Policy == RWPolicy::READER_PREFERRING)
+                return _writer;
+            else
+                return _writer || _waitingWriters > 0;
+        }
+
+        static void Record(RWWaitTime& time, Clock::duration elapsed) noexcept
+        {
+            const auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+            ++time.blocked;
+            time.total += waited;
+            time.max = std::max(time.max, waited);
+        }
+
+    private:
+        mutable std::mutex _mutex;
+        std::condition_variable _readerCv;
+        std::condition_variable _writerCv;
+        bool _writer = false;
+        size_t _readers = 0;
+        size_t _waitingReaders = 0; // PHASE_FAIR: читатели, ждущие следующей фазы чтения
+        size_t _waitingWriters = 0;
+        uint64_t _phase = 0;
+        RWWaitStatistics _statistics;
+    };
+}
+
+#endif /* SharedMutex_h */
@@ -0,0 +1,662 @@
+#ifndef Spinlock_h
+#define Spinlock_h
+
+#include "CacheLine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+#elif defined(_M_ARM64) || defined(_M_ARM)
+    #include <intrin.h>
+#endif
+
+
+/*
+ Простые spinlock из примеров std::atomic (Atomic.cpp) и std::condition_variable (Condition_Variable.cpp), используются в замерах блокировок (Benchmark.cpp).
+ Учебные примеры вложены в пространство имен EXAMPLE, чтобы короткие имена atomic, atomic_flag, cv не конфликтовали с std и другими библиотеками.
+ */
+namespace EXAMPLE
+{
+    namespace atomic
+    {
+        // compare_exchange_weak
+        namespace compare_exchange_strong
+        {
+            class Spinlock
+            {
+                Spinlock(const Spinlock&) = delete;
+            
+            public:
+                Spinlock() = default;
+                ~Spinlock() = default;
+            
+                void Lock() noexcept
+                {
+                    while(_flag);
+                    bool expected = false;
+                    // LOAD (no) ↑ STORE (no)
+                    while (!_flag.compare_exchange_strong(expected, true)) // другой поток мог захватить флаг между while(_flag) и compare_exchange_strong
+                    // LOAD (no) ↓ STORE (no)
+                        expected = false;
+                }
+            
+                bool Try_lock() noexcept
+                {
+                    bool expected = false;
+                    // LOAD (no) ↑ STORE (no)
+                    return _flag.compare_exchange_strong(expected, true);
+                    // LOAD (no) ↓ STORE (no)
+                }
+            
+                void Unlock() noexcept
+                {
+                    // LOAD (no) ↑ STORE (no)
+                    _flag = false;
+                    // LOAD (no) ↓ STORE (no)
+                }
+            
+            private:
+                std::atomic<bool> _flag = ATOMIC_FLAG_INIT; // false
+            };
+        }
+    
+        // compare_exchange_strong
+        namespace compare_exchange_weak
+        {
+            class Spinlock
+            {
+            public:
+                void Lock()
+                {
+                    bool expected = false;
+                    // LOAD (no) ↑ STORE (no)
+                    while (!_flag.compare_exchange_weak(expected, true, std::memory_order_acquire)) // может быть ложное срабатывания
+                    // LOAD (no) ↓ STORE (yes)
+                        expected = false;
+                }
+            
+                bool Try_lock()
+                {
+                    bool expected = false;
+                    // LOAD (no) ↑ STORE (no)
+                    return _flag.compare_exchange_weak(expected, true, std::memory_order_acquire);
+                    // LOAD (no) ↓ STORE (yes)
+                }
+         
+                void Unlock()
+                {
+                    // LOAD (yes) ↑ STORE (no)
+                    _flag.store(false, std::memory_order_release);
+                    // LOAD (no) ↓ STORE (no)
+                }
+         
+            private:
+                std::atomic<bool> _flag;
+            };
+        }
+
+        namespace wait
+        {
+            class Spinlock
+            {
+                Spinlock(const Spinlock&) = delete;
+            
+            public:
+                Spinlock() = default;
+                ~Spinlock() = default;
+            
+                void Lock() noexcept
+                {
+                    // LOAD (no) ↑ STORE (no)
+                    while (_flag.test_and_set(std::memory_order_acquire)) // read, после пробуждения флаг мог захватить другой поток
+                    // LOAD (no) ↓ STORE (yes)
+                        _flag.wait(true);
+                }
+            
+                bool Try_lock() noexcept
+                {
+                    // LOAD (no) ↑ STORE (no)
+                    return !_flag.test_and_set(std::memory_order_acquire);
+                    // LOAD (no) ↓ STORE (yes)
+                }
+            
+                void Unlock() noexcept
+                {
+                    // LOAD (yes) ↑ STORE (no)
+                    _flag.clear(std::memory_order_release); // write
+                    // LOAD (no) ↓ STORE (no)
+                    _flag.notify_one();
+                }
+            
+            private:
+                std::atomic_flag _flag = ATOMIC_FLAG_INIT; // false
+            };
+        }
+    }
+
+    namespace atomic_flag
+    {
+        class Spinlock
+        {
+            Spinlock(const Spinlock&) = delete;
+        
+        public:
+            Spinlock() = default;
+            ~Spinlock() = default;
+        
+            void Lock() noexcept
+            {
+                // LOAD (no) ↑ STORE (no)
+                while (_flag.test_and_set(std::memory_order_acquire)) // read, после пробуждения флаг мог захватить другой поток
+                // LOAD (no) ↓ STORE (yes)
+                    _flag.wait(true);
+            }
+        
+            bool Try_lock() noexcept
+            {
+                // LOAD (no) ↑ STORE (no)
+                return !_flag.test_and_set(std::memory_order_acquire);
+                // LOAD (no) ↓ STORE (yes)
+            }
+        
+            void Unlock() noexcept
+            {
+                // LOAD (yes) ↑ STORE (no)
+                _flag.clear(std::memory_order_release); // write
+                // LOAD (no) ↓ STORE (no)
+                _flag.notify_one();
+            }
+        
+        private:
+            std::atomic_flag _flag = ATOMIC_FLAG_INIT; // false
+        };
+    }
+
+    namespace cv
+    {
+        class Spinlock
+        {
+            Spinlock(const Spinlock&) = delete;
+        
+        public:
+            Spinlock() = default;
+            ~Spinlock() = default;
+        
+            void Lock() noexcept
+            {
+                std::unique_lock lock(_mutex);
+                _cv.wait(lock, [this] { return !_flag.exchange(true); });
+            }
+        
+            bool Try_lock() noexcept
+            {
+                return !_flag.exchange(true);
+            }
+        
+            void Unlock() noexcept
+            {
+                // Флаг сбрасывается под mutex и до notify_one: иначе ожидающий поток может проверить флаг до сброса и уснуть, пропустив уведомление (lost wakeup)
+                {
+                    std::lock_guard lock(_mutex);
+                    _flag = false;
+                }
+                _cv.notify_one();
+            }
+        
+        private:
+            std::atomic<bool> _flag;
+            std::mutex _mutex;
+            std::condition_variable _cv;
+        };
+    }
+}
+
+/*
+ Подсказка процессору, что поток крутится в цикле ожидания (spin-wait):
+ - x86: pause - снижает энергопотребление и убирает штраф за ошибочное предсказание (memory order violation) при выходе из цикла, освобождает ресурсы ядра для соседнего гиперпотока (Hyper-Threading).
+ - ARM: yield - аналогичная подсказка.
+ - иначе: std::this_thread::yield - отдать квант времени другому потоку.
+ */
+inline void CpuPause() noexcept
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(_M_ARM64) || defined(_M_ARM)
+    __yield();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+/*
+ Ограниченная экспоненциальная задержка (bounded exponential backoff): после каждой неудачной попытки захвата кол-во pause удваивается (1, 2, 4, ... MAX_SPIN), поэтому потоки расходятся по времени и реже одновременно бросаются на освободившуюся блокировку.
+ Когда задержка достигает MAX_SPIN, поток отдает квант времени (yield), чтобы не жечь процессор, если владелец блокировки вытеснен.
+ */
+class Backoff
+{
+public:
+    void Pause() noexcept
+    {
+        if (_count <= MAX_SPIN)
+        {
+            for (uint32_t i = 0; i < _count; ++i)
+                CpuPause();
+            _count <<= 1;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void Reset() noexcept
+    {
+        _count = 1;
+    }
+
+private:
+    static constexpr uint32_t MAX_SPIN = 1024;
+
+    uint32_t _count = 1;
+};
+
+/*
+ TTAS (test-and-test-and-set) Spinlock.
+ Проблема обычного spinlock (test-and-set/compare_exchange в цикле): каждая попытка захвата - запись, поэтому кэш-линия с флагом постоянно перебрасывается между ядрами (cache line bouncing), даже когда блокировка занята и захват заведомо не удастся.
+ Решение:
+ 1. test - ожидание на чтении (load): пока блокировка занята, каждое ядро читает флаг из своего кэша (состояние Shared в MESI) и не генерирует трафик по шине.
+ 2. test-and-set - запись (exchange) только когда флаг стал свободным.
+ 3. между попытками - CpuPause + Backoff.
+ Флаг выровнен по кэш-линии, чтобы не делить ее с защищаемыми данными (false sharing).
+ Методы Lock/Try_lock/Unlock, а также lock/try_lock/unlock - требования Lockable, поэтому работает с std::lock_guard/std::unique_lock/std::scoped_lock.
+ */
+namespace TTAS
+{
+    class Spinlock
+    {
+        Spinlock(const Spinlock&) = delete;
+        Spinlock& operator=(const Spinlock&) = delete;
+
+    public:
+        Spinlock() = default;
+        ~Spinlock() = default;
+
+        void Lock() noexcept
+        {
+            Backoff backoff;
+            while (true)
+            {
+                // LOAD (no) ↑ STORE (no)
+                if (!_flag.exchange(true, std::memory_order_acquire)) // test-and-set
+                // LOAD (no) ↓ STORE (yes)
+                    return;
+
+                while (_flag.load(std::memory_order_relaxed)) // test: чтение из своего кэша, без записи
+                    backoff.Pause();
+            }
+        }
+
+        bool Try_lock() noexcept
+        {
+            // Сначала чтение: если занято, то не делаем запись
+            // LOAD (no) ↑ STORE (no)
+            return !_flag.load(std::memory_order_relaxed) && !_flag.exchange(true, std::memory_order_acquire);
+            // LOAD (no) ↓ STORE (yes)
+        }
+
+        void Unlock() noexcept
+        {
+            // LOAD (yes) ↑ STORE (no)
+            _flag.store(false, std::memory_order_release);
+            // LOAD (no) ↓ STORE (no)
+        }
+
+        // Lockable
+        void lock() noexcept { Lock(); }
+        bool try_lock() noexcept { return Try_lock(); }
+        void unlock() noexcept { Unlock(); }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<bool> _flag = false;
+    };
+}
+
+/*
+ Ticket Spinlock (билетная блокировка) - справедливая (FIFO) блокировка: потоки захватывают ее строго в порядке очереди, поэтому ни один поток не голодает (starvation), а время ожидания ограничено кол-вом потоков впереди.
+ Принцип работы как электронная очередь:
+ 1. Lock - поток берет билет: _next.fetch_add(1), и ждет, пока _serving (номер обслуживаемого билета) не станет равным его билету.
+ 2. Unlock - _serving + 1: обслуживается следующий билет.
+ Пропорциональная задержка (proportional backoff): поток знает свое место в очереди (билет - _serving), поэтому ждет пропорционально расстоянию и реже читает _serving.
+ _next и _serving в разных кэш-линиях: взятие билета не мешает ожидающим потокам читать _serving.
+ Замечание: в отличии от TTAS ожидающий поток не может уступить очередь, поэтому если владелец или следующий в очереди поток вытеснен планировщиком, то ждут все. Поэтому после MAX_SPIN попыток поток отдает квант времени (yield). Подходит для коротких критических секций при кол-ве потоков <= кол-ва ядер.
+ */
+namespace TICKET
+{
+    class Spinlock
+    {
+        Spinlock(const Spinlock&) = delete;
+        Spinlock& operator=(const Spinlock&) = delete;
+
+    public:
+        Spinlock() = default;
+        ~Spinlock() = default;
+
+        void Lock() noexcept
+        {
+            // LOAD (yes) ↑ STORE (yes)
+            const uint32_t ticket = _next.fetch_add(1, std::memory_order_relaxed);
+            // LOAD (yes) ↓ STORE (yes)
+            for (uint32_t spin = 0;; ++spin)
+            {
+                // LOAD (no) ↑ STORE (no)
+                const uint32_t serving = _serving.load(std::memory_order_acquire);
+                // LOAD (no) ↓ STORE (yes)
+                if (serving == ticket)
+                    return;
+
+                // Расстояние до начала очереди (переполнение uint32_t не мешает разности): следующий в очереди ждет 1 pause, остальные - пропорционально
+                for (uint32_t i = 0, pause = (ticket - serving - 1) * PAUSE_PER_TICKET + 1; i < pause; ++i)
+                    CpuPause();
+                // Долгое ожидание - вероятно потоков больше, чем ядер: отдаем квант времени, место в очереди сохраняется
+                if (spin >= MAX_SPIN)
+                    std::this_thread::yield();
+            }
+        }
+
+        bool Try_lock() noexcept
+        {
+            // Захват только если очередь пуста: билет == обслуживаемому
+            uint32_t ticket = _serving.load(std::memory_order_relaxed);
+            if (_next.load(std::memory_order_relaxed) != ticket)
+                return false;
+            // LOAD (no) ↑ STORE (no)
+            return _next.compare_exchange_strong(ticket, ticket + 1, std::memory_order_acquire, std::memory_order_relaxed);
+            // LOAD (no) ↓ STORE (yes)
+        }
+
+        void Unlock() noexcept
+        {
+            // _serving меняет только владелец блокировки, поэтому достаточно load + store
+            const uint32_t serving = _serving.load(std::memory_order_relaxed);
+            // LOAD (yes) ↑ STORE (no)
+            _serving.store(serving + 1, std::memory_order_release);
+            // LOAD (no) ↓ STORE (no)
+        }
+
+        // Lockable
+        void lock() noexcept { Lock(); }
+        bool try_lock() noexcept { return Try_lock(); }
+        void unlock() noexcept { Unlock(); }
+
+    private:
+        static constexpr uint32_t PAUSE_PER_TICKET = 32; // примерная длительность короткой критической секции в pause
+        static constexpr uint32_t MAX_SPIN = 64;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> _next = 0;    // следующий билет
+        alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> _serving = 0; // обслуживаемый билет
+    };
+}
+
+/*
+ MCS Spinlock (Mellor-Crummey, Scott) - очередь ожидающих потоков в виде односвязного списка узлов (Node), каждый поток ждет на флаге СВОЕГО узла.
+ Проблема TTAS/Ticket: все ожидающие потоки читают одну кэш-линию, поэтому Unlock инвалидирует ее в кэше каждого ядра и все ядра одновременно читают ее заново (O(кол-во ядер) трафика на каждую передачу блокировки).
+ Решение:
+ 1. Lock - поток добавляет свой узел в хвост очереди (_tail.exchange) и ждет на своем флаге locked, который лежит в своей кэш-линии.
+ 2. Unlock - владелец сбрасывает флаг только следующего узла: передача блокировки затрагивает одну чужую кэш-линию (O(1)), порядок - FIFO.
+ Узел живет все время владения блокировкой, поэтому используется Guard (RAII), который хранит узел на стеке:
+     MCS::Spinlock::Guard guard(spinlock);
+ */
+namespace MCS
+{
+    class Spinlock
+    {
+        Spinlock(const Spinlock&) = delete;
+        Spinlock& operator=(const Spinlock&) = delete;
+
+    public:
+        // Узел в своей кэш-линии: ожидание на locked не мешает другим потокам
+        struct alignas(CACHE_LINE_SIZE) Node
+        {
+            std::atomic<Node*> next = nullptr;
+            std::atomic<bool> locked = false;
+        };
+
+        class Guard
+        {
+            Guard(const Guard&) = delete;
+            Guard& operator=(const Guard&) = delete;
+
+        public:
+            explicit Guard(Spinlock& spinlock) noexcept : _spinlock(spinlock)
+            {
+                _spinlock.Lock(_node);
+            }
+
+            ~Guard() noexcept
+            {
+                _spinlock.Unlock(_node);
+            }
+
+        private:
+            Spinlock& _spinlock;
+            Node _node;
+        };
+
+    public:
+        Spinlock() = default;
+        ~Spinlock() = default;
+
+        void Lock(Node& node) noexcept
+        {
+            node.next.store(nullptr, std::memory_order_relaxed);
+            node.locked.store(true, std::memory_order_relaxed);
+            // release - публикация инициализированного узла, acquire - захват после Unlock предыдущего владельца
+            // LOAD (no) ↑ STORE (no)
+            Node* prev = _tail.exchange(&node, std::memory_order_acq_rel);
+            // LOAD (no) ↓ STORE (no)
+            if (!prev) // очередь была пуста
+                return;
+
+            // LOAD (yes) ↑ STORE (no)
+            prev->next.store(&node, std::memory_order_release);
+            // LOAD (no) ↓ STORE (no)
+            for (uint32_t spin = 0; node.locked.load(std::memory_order_acquire); ++spin) // ожидание на своей кэш-линии
+                Relax(spin);
+        }
+
+        bool Try_lock(Node& node) noexcept
+        {
+            node.next.store(nullptr, std::memory_order_relaxed);
+            node.locked.store(true, std::memory_order_relaxed);
+            Node* expected = nullptr;
+            // LOAD (no) ↑ STORE (no)
+            return _tail.compare_exchange_strong(expected, &node, std::memory_order_acq_rel, std::memory_order_relaxed);
+            // LOAD (no) ↓ STORE (no)
+        }
+
+        void Unlock(Node& node) noexcept
+        {
+            Node* next = node.next.load(std::memory_order_acquire);
+            if (!next)
+            {
+                // Нет следующего: пытаемся освободить очередь
+                Node* expected = &node;
+                // LOAD (yes) ↑ STORE (no)
+                if (_tail.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed))
+                // LOAD (no) ↓ STORE (no)
+                    return;
+
+                // Следующий поток уже сделал exchange, но еще не записал prev->next
+                for (uint32_t spin = 0; !(next = node.next.load(std::memory_order_acquire)); ++spin)
+                    Relax(spin);
+            }
+            // LOAD (yes) ↑ STORE (no)
+            next->locked.store(false, std::memory_order_release);
+            // LOAD (no) ↓ STORE (no)
+        }
+
+    private:
+        // Долгое ожидание - вероятно потоков больше, чем ядер: отдаем квант времени, место в очереди сохраняется
+        static void Relax(uint32_t spin) noexcept
+        {
+            if (spin < MAX_SPIN)
+                CpuPause();
+            else
+                std::this_thread::yield();
+        }
+
+    private:
+        static constexpr uint32_t MAX_SPIN = 1024;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<Node*> _tail = nullptr; // последний узел очереди
+    };
+}
+
+/*
+ Адаптивный spinlock (spin-then-park): сначала крутится в цикле ожидания, затем засыпает на атомарном слове (std::atomic::wait - futex в Linux, WaitOnAddress в Windows, ulock в macOS).
+ Проблема:
+ - atomic::wait::Spinlock сразу засыпает: даже для короткой критической секции - поход в ядро на Lock и Unlock.
+ - compare_exchange Spinlock никогда не засыпает: при длинной критической секции или вытесненном владельце жжет процессор.
+ Решение:
+ 1. Три состояния: UNLOCKED (свободен), LOCKED (захвачен, никто не спит), CONTENDED (захвачен, возможно есть спящие потоки). Unlock вызывает notify_one только в состоянии CONTENDED, поэтому без конкуренции в ядро не ходим.
+ 2. Бюджет ожидания (кол-во pause) подстраивается под время владения блокировкой: владелец измеряет время владения (выборочно, каждый SAMPLE-й захват, чтобы не читать часы на каждом захвате), бюджет = 2 * среднее время владения / время одного pause. Короткие критические секции - поток дожидается в цикле, длинные - почти сразу засыпает.
+ 3. Время одного pause калибруется один раз при первом использовании (на x86 pause длится от ~10 до ~140 тактов в зависимости от процессора).
+ */
+namespace ADAPTIVE
+{
+    class Spinlock
+    {
+        Spinlock(const Spinlock&) = delete;
+        Spinlock& operator=(const Spinlock&) = delete;
+
+        using Clock = std::chrono::steady_clock;
+
+        enum State : uint32_t
+        {
+            UNLOCKED,
+            LOCKED,
+            CONTENDED
+        };
+
+    public:
+        // Калибровка CpuPause - при создании первой блокировки, а не в Unlock под блокировкой (иначе первый замер держит всех ожидающих)
+        Spinlock() noexcept : _pauseNanoseconds(PauseNanoseconds()) {}
+        ~Spinlock() = default;
+
+        void Lock() noexcept
+        {
+            uint32_t state = UNLOCKED;
+            // LOAD (no) ↑ STORE (no)
+            if (!_state.compare_exchange_strong(state, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+            // LOAD (no) ↓ STORE (yes)
+            {
+                // 1. Ожидание в цикле
+                for (uint32_t spin = 0, budget = _spinBudget.load(std::memory_order_relaxed); spin < budget; ++spin)
+                {
+                    CpuPause();
+                    state = _state.load(std::memory_order_relaxed);
+                    if (state == UNLOCKED && _state.compare_exchange_weak(state, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+                        return Acquired();
+                }
+
+                // 2. Сон: захват сразу в состоянии CONTENDED, т.к. неизвестно остались ли еще спящие потоки
+                if (state != CONTENDED)
+                    state = _state.exchange(CONTENDED, std::memory_order_acquire);
+                while (state != UNLOCKED)
+                {
+                    _state.wait(CONTENDED, std::memory_order_relaxed);
+                    state = _state.exchange(CONTENDED, std::memory_order_acquire);
+                }
+            }
+            Acquired();
+        }
+
+        bool Try_lock() noexcept
+        {
+            uint32_t state = UNLOCKED;
+            // LOAD (no) ↑ STORE (no)
+            if (!_state.compare_exchange_strong(state, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+            // LOAD (no) ↓ STORE (yes)
+                return false;
+
+            Acquired();
+            return true;
+        }
+
+        void Unlock() noexcept
+        {
+            if (_sampled)
+                Measure();
+            // LOAD (yes) ↑ STORE (no)
+            if (_state.exchange(UNLOCKED, std::memory_order_release) == CONTENDED) // будим, только если кто-то мог уснуть
+            // LOAD (no) ↓ STORE (no)
+                _state.notify_one();
+        }
+
+        // Текущий бюджет ожидания в pause
+        uint32_t SpinBudget() const noexcept
+        {
+            return _spinBudget.load(std::memory_order_relaxed);
+        }
+
+        // Lockable
+        void lock() noexcept { Lock(); }
+        bool try_lock() noexcept { return Try_lock(); }
+        void unlock() noexcept { Unlock(); }
+
+    private:
+        // Вызывается владельцем блокировки, поэтому _acquisitions/_sampled/_lockTime/_holdTime без atomic
+        void Acquired() noexcept
+        {
+            _sampled = (++_acquisitions % SAMPLE) == 0;
+            if (_sampled)
+                _lockTime = Clock::now();
+        }
+
+        void Measure() noexcept
+        {
+            const double holdTime = std::chrono::duration<double, std::nano>(Clock::now() - _lockTime).count();
+            _holdTime += (holdTime - _holdTime) / 8; // скользящее среднее
+            const double budget = 2 * _holdTime / _pauseNanoseconds;
+            _spinBudget.store((uint32_t)std::clamp(budget, (double)MIN_SPIN, (double)MAX_SPIN), std::memory_order_relaxed);
+        }
+
+        // Калибровка: время одного CpuPause в нс
+        static double PauseNanoseconds() noexcept
+        {
+            static const double nanoseconds = []()
+            {
+                constexpr int count = 10000;
+                const auto start = Clock::now();
+                for (int i = 0; i < count; ++i)
+                    CpuPause();
+                return std::max(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count, 1.0);
+            }();
+            return nanoseconds;
+        }
+
+    private:
+        static constexpr uint32_t MIN_SPIN = 16;
+        static constexpr uint32_t MAX_SPIN = 16384;
+        static constexpr uint32_t SAMPLE = 16;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> _state = UNLOCKED;
+        std::atomic<uint32_t> _spinBudget = 256;
+        uint32_t _acquisitions = 0;
+        bool _sampled = false;
+        Clock::time_point _lockTime;
+        double _holdTime = 0;
+        const double _pauseNanoseconds; // время одного CpuPause в нс
+    };
+}
+
+#endif /* Spinlock_h */
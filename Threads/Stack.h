@@ -0,0 +1,380 @@
+#ifndef ThreadSafeStack_h
+#define ThreadSafeStack_h
+
+#include "AtomicWide.h"
+#include "CacheLine.h"
+#include "HazardPointer.h"
+#include "Spinlock.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stack>
+#include <utility>
+
+
+/*
+ Потокобезопасный стек (LIFO).
+ */
+
+/*
+ Стек на std::mutex - базовый вариант для сравнения.
+ */
+namespace MUTEX
+{
+    template <typename T>
+    class ThreadSafeStack
+    {
+        ThreadSafeStack(const ThreadSafeStack&) = delete;
+        ThreadSafeStack& operator = (const ThreadSafeStack&) = delete;
+        
+    public:
+        ThreadSafeStack() = default;
+        
+        void Push(T&& value)
+        {
+            std::lock_guard lock(_mutex);
+            _stack.push(std::move(value));
+        }
+        
+        std::optional<T> Pop()
+        {
+            std::lock_guard lock(_mutex);
+            if (_stack.empty())
+                return std::nullopt;
+            
+            std::optional<T> item(std::move(_stack.top()));
+            _stack.pop();
+            return item;
+        }
+        
+        bool Empty() const
+        {
+            std::lock_guard lock(_mutex);
+            return _stack.empty();
+        }
+        
+    private:
+        mutable std::mutex _mutex;
+        std::stack<T> _stack;
+    };
+}
+
+/*
+ Lock-free стек Трайбера (Treiber): вершина _head меняется compare_exchange.
+ Освобождение узлов - hazard pointers (HazardPointer.h):
+ - Pop защищает вершину, поэтому читать head->next безопасно: узел не освобожден.
+ - защищенный узел не может быть освобожден и выделен заново по тому же адресу, поэтому нет проблемы ABA (compare_exchange не спутает старую вершину с новой по тому же адресу).
+ */
+namespace HAZARD_POINTER
+{
+    template <typename T>
+    class ThreadSafeStack
+    {
+        struct Node
+        {
+            T value;
+            Node* next = nullptr;
+        };
+        
+        ThreadSafeStack(const ThreadSafeStack&) = delete;
+        ThreadSafeStack& operator = (const ThreadSafeStack&) = delete;
+        
+    public:
+        ThreadSafeStack() = default;
+        
+        ~ThreadSafeStack()
+        {
+            Node* node = _head.load();
+            while (node)
+                delete std::exchange(node, node->next);
+        }
+        
+        void Push(T&& value)
+        {
+            Node* node = new Node{std::move(value), _head.load(std::memory_order_relaxed)};
+            // LOAD (yes) ↑ STORE (no)
+            while (!_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)); // публикация узла
+            // LOAD (no) ↓ STORE (no)
+        }
+        
+        std::optional<T> Pop()
+        {
+            HP::HazardPointer hazard;
+            while (true)
+            {
+                Node* head = hazard.Protect(_head);
+                if (!head)
+                    return std::nullopt;
+                
+                // LOAD (no) ↑ STORE (no)
+                if (_head.compare_exchange_weak(head, head->next, std::memory_order_acquire, std::memory_order_relaxed))
+                // LOAD (no) ↓ STORE (yes)
+                {
+                    std::optional<T> item(std::move(head->value)); // узел удален из стека, его значение читает только этот поток
+                    hazard.Reset();
+                    HP::Retire(head);
+                    return item;
+                }
+            }
+        }
+        
+        bool Empty() const noexcept
+        {
+            return _head.load(std::memory_order_acquire) == nullptr;
+        }
+        
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<Node*> _head = nullptr;
+    };
+}
+
+/*
+ Lock-free стек Трайбера с меткой (tagged pointer): вершина - пара {указатель, метка} в AtomicWide (AtomicWide.h), метка увеличивается при каждом изменении вершины.
+ Проблема ABA: поток A прочитал вершину X и X->next = Y, поток B извлек X и Y, затем снова добавил X. Вершина снова X, поэтому compare_exchange потока A пройдет и запишет в вершину уже извлеченный Y.
+ Решение: compare_exchange сравнивает указатель вместе с меткой, а у вернувшегося X метка другая.
+ Узлы не освобождаются, а переиспользуются через собственный список свободных узлов (free-list, тоже стек с меткой), поэтому чтение X->next после извлечения X другим потоком безопасно: память узла жива до деструктора стека.
+ Замечание: lock-free, если есть сравнение с обменом двойной ширины (AtomicWide<T>::IS_LOCK_FREE), иначе вершина защищена полосатой блокировкой.
+ */
+namespace TAGGED
+{
+    template <typename T>
+    class ThreadSafeStack
+    {
+        struct Node
+        {
+            std::optional<T> value;
+            std::atomic<Node*> next = nullptr; // читается потоками, которые проиграли compare_exchange, поэтому атомарный
+        };
+        
+        struct Top
+        {
+            Node* node = nullptr;
+            uintptr_t tag = 0;
+        };
+        
+        ThreadSafeStack(const ThreadSafeStack&) = delete;
+        ThreadSafeStack& operator = (const ThreadSafeStack&) = delete;
+        
+    public:
+        static constexpr bool IS_LOCK_FREE = AtomicWide<Top>::IS_LOCK_FREE;
+        
+    public:
+        ThreadSafeStack() = default;
+        
+        ~ThreadSafeStack()
+        {
+            for (Node* node : { _head.Load().node, _free.Load().node })
+            {
+                while (node)
+                    delete std::exchange(node, node->next.load(std::memory_order_relaxed));
+            }
+        }
+        
+        void Push(T&& value)
+        {
+            Node* node = PopNode(_free);
+            if (!node)
+                node = new Node;
+            node->value.emplace(std::move(value));
+            PushNode(_head, node); // публикация узла
+        }
+        
+        std::optional<T> Pop()
+        {
+            Node* node = PopNode(_head);
+            if (!node)
+                return std::nullopt;
+            
+            std::optional<T> item(std::move(node->value)); // узел удален из стека, его значение читает только этот поток
+            node->value.reset();
+            PushNode(_free, node);
+            return item;
+        }
+        
+        bool Empty() const noexcept
+        {
+            return _head.Load().node == nullptr;
+        }
+        
+    private:
+        // compare_exchange AtomicWide - полный барьер памяти (seq_cst)
+        static void PushNode(AtomicWide<Top>& top, Node* node) noexcept
+        {
+            Top expected = top.Load();
+            do
+            {
+                node->next.store(expected.node, std::memory_order_relaxed);
+            }
+            while (!top.CompareExchange(expected, { node, expected.tag + 1 }));
+        }
+        
+        static Node* PopNode(AtomicWide<Top>& top) noexcept
+        {
+            Top expected = top.Load();
+            while (expected.node)
+            {
+                // Узел мог быть уже извлечен и переиспользован другим потоком: next устарел, но тогда изменилась метка и compare_exchange не пройдет
+                Node* next = expected.node->next.load(std::memory_order_relaxed);
+                if (top.CompareExchange(expected, { next, expected.tag + 1 }))
+                    return expected.node;
+            }
+            return nullptr;
+        }
+        
+    private:
+        AtomicWide<Top> _head;
+        AtomicWide<Top> _free; // свободные узлы
+    };
+}
+
+/*
+ Стек с исключением (elimination-backoff stack): стек Трайбера (hazard pointers) + массив исключения (elimination array).
+ Проблема: при большой конкуренции все потоки делают compare_exchange одной вершины, поэтому стек не масштабируется.
+ Решение: одновременные Push и Pop взаимно уничтожаются - Pop получает значение Push напрямую, вершина стека не меняется (LIFO не нарушается: Push, сразу за ним Pop).
+ Принцип работы: поток, проигравший compare_exchange вершины, вместо паузы (backoff) идет в случайную ячейку массива исключения:
+ - Push - записывает свой узел в пустую ячейку, ждет SPIN итераций, затем пытается забрать узел обратно. Не удалось - узел забрал Pop, значение передано.
+ - Pop - ждет до SPIN итераций узел в ячейке и забирает его, заменив на TAKEN.
+ Ячейку очищает только Push, поэтому пока ячейка занята его узлом или TAKEN, адрес узла не может быть переиспользован другим Push (нет ABA в ячейке).
+ Если партнер не найден, поток снова пробует вершину стека.
+ */
+namespace ELIMINATION
+{
+    template <typename T>
+    class ThreadSafeStack
+    {
+        struct Node
+        {
+            T value;
+            Node* next = nullptr;
+        };
+        
+        static constexpr size_t SLOTS = 8; // ячейки массива исключения, каждая в своей кэш-линии
+        static constexpr int SPIN = 128; // ожидание партнера, итераций CpuPause
+        
+        ThreadSafeStack(const ThreadSafeStack&) = delete;
+        ThreadSafeStack& operator = (const ThreadSafeStack&) = delete;
+        
+    public:
+        ThreadSafeStack() = default;
+        
+        ~ThreadSafeStack()
+        {
+            Node* node = _head.load();
+            while (node)
+                delete std::exchange(node, node->next);
+        }
+        
+        void Push(T&& value)
+        {
+            Node* node = new Node{std::move(value), _head.load(std::memory_order_relaxed)};
+            while (true)
+            {
+                // LOAD (yes) ↑ STORE (no)
+                if (_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) // публикация узла
+                    return;
+                // LOAD (no) ↓ STORE (no)
+                
+                if (EliminatePush(node))
+                    return;
+                
+                node->next = _head.load(std::memory_order_relaxed);
+            }
+        }
+        
+        std::optional<T> Pop()
+        {
+            HP::HazardPointer hazard;
+            while (true)
+            {
+                Node* head = hazard.Protect(_head);
+                if (!head)
+                    return std::nullopt;
+                
+                // LOAD (no) ↑ STORE (no)
+                if (_head.compare_exchange_strong(head, head->next, std::memory_order_acquire, std::memory_order_relaxed))
+                // LOAD (no) ↓ STORE (yes)
+                {
+                    std::optional<T> item(std::move(head->value)); // узел удален из стека, его значение читает только этот поток
+                    hazard.Reset();
+                    HP::Retire(head);
+                    return item;
+                }
+                
+                hazard.Reset();
+                if (Node* node = EliminatePop())
+                {
+                    std::optional<T> item(std::move(node->value)); // узел не был в стеке, его не видит ни один поток
+                    delete node;
+                    return item;
+                }
+            }
+        }
+        
+        bool Empty() const noexcept
+        {
+            return _head.load(std::memory_order_acquire) == nullptr;
+        }
+        
+    private:
+        static Node* Taken() noexcept
+        {
+            return reinterpret_cast<Node*>(uintptr_t(1));
+        }
+        
+        // Случайная ячейка (xorshift): разные пары потоков расходятся по разным ячейкам
+        std::atomic<Node*>& RandomSlot() noexcept
+        {
+            thread_local uint32_t state = uint32_t(ThreadIndex()) * 2654435761u + 1;
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return *_slots[state % SLOTS];
+        }
+        
+        // true - узел передан Pop
+        bool EliminatePush(Node* node) noexcept
+        {
+            std::atomic<Node*>& slot = RandomSlot();
+            Node* expected = nullptr;
+            // LOAD (yes) ↑ STORE (no)
+            if (!slot.compare_exchange_strong(expected, node, std::memory_order_release, std::memory_order_relaxed)) // ячейка занята
+                return false;
+            // LOAD (no) ↓ STORE (no)
+            
+            for (int i = 0; i < SPIN && slot.load(std::memory_order_relaxed) == node; ++i)
+                CpuPause();
+            
+            expected = node;
+            if (slot.compare_exchange_strong(expected, nullptr, std::memory_order_relaxed)) // партнер не пришел - узел забран обратно
+                return false;
+            
+            slot.store(nullptr, std::memory_order_relaxed); // expected == TAKEN
+            return true;
+        }
+        
+        // Узел Push или nullptr
+        Node* EliminatePop() noexcept
+        {
+            std::atomic<Node*>& slot = RandomSlot();
+            for (int i = 0; i < SPIN; ++i)
+            {
+                Node* node = slot.load(std::memory_order_relaxed);
+                // LOAD (no) ↑ STORE (no)
+                if (node && node != Taken() && slot.compare_exchange_strong(node, Taken(), std::memory_order_acquire, std::memory_order_relaxed))
+                    return node;
+                // LOAD (no) ↓ STORE (yes)
+                CpuPause();
+            }
+            return nullptr;
+        }
+        
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<Node*> _head = nullptr;
+        std::array<Padded<std::atomic<Node*>>, SLOTS> _slots{};
+    };
+}
+
+#endif /* ThreadSafeStack_h */
@@ -1,4 +1,6 @@
 #include "Atomic.hpp"
+#include "Epoch.h"
+#include "Benchmark.hpp"
 #include "Condition_Variable.hpp"
 #include "Coroutine.hpp"
 #include "Promise_Future.hpp"
@@ -11,13 +13,15 @@
 #include "Semaphore.hpp"
 #include "Timer.h"
 #include "Queue.h"
+#include "Stack.h"
 
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <future>
 #include <numeric>
+#include <random>
 #include <ranges>
-#include <stack>
 #include <vector>
 
 
@@ -25,6 +29,8 @@
     #include "OpenMP.h"
     #include "TBB.h"
 
+    #include <tbb/concurrent_priority_queue.h>
+
     #include <syncstream>
 #endif
 
@@ -47,6 +53,37 @@
            https://www.geeksforgeeks.org/std-barrier-in-cpp-20/
 */
 
+/*
+ Счетчик выделений памяти в куче - замена глобального operator new, подсчитывает все выделения в программе.
+ Используется, чтобы проверить, что очередь не выделяет память после прогрева.
+ Замена operator new меняет поведение аллокатора для всей программы (все примеры, TBB, OpenMP), поэтому включается только в сборке для замеров: COUNT_ALLOCATIONS = 1.
+ */
+#ifndef COUNT_ALLOCATIONS
+    #define COUNT_ALLOCATIONS 0
+#endif
+
+#if COUNT_ALLOCATIONS
+static std::atomic<size_t> allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+#endif
+
 class MyClass
 {
 public:
@@ -97,11 +134,89 @@ void Multi2(int number, int factor, int& result)
     result = number * factor;
 }
 
+/*
+ Пропускная способность очереди: producers потоков записывают по count сообщений, consumers потоков читают все сообщения.
+ Возвращает кол-во сообщений в секунду.
+ */
+template <class TQueue>
+double Throughput(TQueue& queue, int producers, int consumers, int count)
+{
+    Timer timer;
+    const int total = producers * count;
+    std::vector<std::thread> threads;
+    threads.reserve(producers + consumers);
+    
+    timer.start();
+    for (int i = 0; i < producers; ++i)
+    {
+        threads.emplace_back([&]()
+            {
+                for (int j = 0; j < count; ++j)
+                    queue.Push(int(j));
+            });
+    }
+    for (int i = 0; i < consumers; ++i)
+    {
+        threads.emplace_back([&, i]()
+            {
+                const int size = total / consumers + (i == 0 ? total % consumers : 0);
+                for (int j = 0; j < size; ++j)
+                    queue.Pop();
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    timer.stop();
+    
+    return total / std::max(timer.elapsedSeconds(), 0.001);
+}
 
-int main()
+/*
+ Пропускная способность стека при симметричной нагрузке: threads потоков count раз делают Push + Pop.
+ Возвращает кол-во операций в секунду.
+ */
+template <class TStack>
+double StackThroughput(TStack& stack, int threads, int count)
+{
+    Timer timer;
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    
+    timer.start();
+    for (int i = 0; i < threads; ++i)
+    {
+        workers.emplace_back([&]()
+            {
+                for (int j = 0; j < count; ++j)
+                {
+                    stack.Push(int(j));
+                    stack.Pop();
+                }
+            });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    timer.stop();
+    
+    return 2.0 * threads * count / std::max(timer.elapsedSeconds(), 0.001);
+}
+
+
+int main(int argc, char* argv[])
 {
     setlocale(LC_ALL, "Russian");
     
+    // Только замеры блокировок: Threads --benchmark [locks.csv] [locks.json]
+    if (argc > 1 && std::string(argv[1]) == "--benchmark")
+    {
+        BENCHMARK::Start(argc > 2 ? argv[2] : "locks.csv", argc > 3 ? argv[3] : "locks.json");
+        return 0;
+    }
+    
     Timer timer;
     constexpr int size = 100;
     std::vector<int> numbers(size);
@@ -279,10 +394,10 @@ int main()
                     
                     std::cout << "Перехват исключений (exception catching)" << std::endl;
                     
-                    // 1 Способ: std::stack<std::exception_ptr>
+                    // 1 Способ: стек std::exception_ptr (потоки добавляют исключения одновременно, поэтому стек потокобезопасный - TAGGED::ThreadSafeStack)
                     {
-                        std::cout << "1 Способ: std::stack<std::exception_ptr>" << std::endl;
-                        std::stack<std::exception_ptr> exception_queue;
+                        std::cout << "1 Способ: TAGGED::ThreadSafeStack<std::exception_ptr>" << std::endl;
+                        TAGGED::ThreadSafeStack<std::exception_ptr> exception_queue;
                         auto Function = [&]()
                         {
                             try
@@ -293,20 +408,20 @@ int main()
                             catch (...)
                             {
                                 std::exception_ptr exception = std::current_exception();
-                                exception_queue.push(exception);
+                                exception_queue.Push(std::move(exception));
                             }
                         };
                         
-                        std::thread thread(Function);
-                        thread.join();
+                        std::thread thread1(Function);
+                        std::thread thread2(Function);
+                        thread1.join();
+                        thread2.join();
                         
-                        while (!exception_queue.empty())
+                        while (auto exception = exception_queue.Pop())
                         {
                             try
                             {
-                                auto exception = exception_queue.top();
-                                exception_queue.pop();
-                                std::rethrow_exception(exception);
+                                std::rethrow_exception(*exception);
                             }
                             catch (const std::exception& exception)
                             {
@@ -509,11 +624,88 @@ int main()
                     messages.Push("2");
                     messages.Push("3");
                     
-                    while (!messages.Empty())
+                    // TryPop - проверка и извлечение за 1 захват mutex (Empty + Pop - 2 захвата и Pop может заблокироваться, если элемент заберет другой читатель)
+                    std::string result;
+                    while (messages.TryPop(result))
                     {
-                        auto result = messages.Pop();
                     }
-                    
+
+                    // WaitPopFor - очередь пуста, других читателей нет: ждет не дольше 10 мс и возвращает false
+                    {
+                        const bool popped = messages.WaitPopFor(result, std::chrono::milliseconds(10));
+                        std::cout << "WaitPopFor на пустой очереди: " << std::boolalpha << popped << " (ожидается false)" << std::endl;
+                    }
+
+                    // Close - единственный читатель завершается без сообщений-маркеров: дочитывает 4 5, затем Pop возвращает пустой std::optional
+                    {
+                        std::thread consumer([&messages]()
+                            {
+                                while (auto message = messages.Pop()) // пустой std::optional - очередь закрыта и пуста
+                                {
+                                    std::cout << *message << " ";
+                                }
+                                std::cout << "(ожидается 4 5)" << std::endl;
+                            });
+                        
+                        messages.Push("4");
+                        messages.Push("5");
+                        messages.Close();
+                        consumer.join();
+                        
+                        const bool pushed = messages.Push("6"); // очередь закрыта - элемент не добавлен
+                        std::cout << "Push после Close: " << std::boolalpha << pushed << " (ожидается false)" << std::endl;
+                    }
+
+                    // PushRange/PopBulk - пакетная запись/чтение под одной блокировкой: 4 писателя + 4 читателя
+                    for (size_t batch = 1; batch <= 1024; batch *= 2)
+                    {
+                        constexpr int producers = 4, consumers = 4, count = 1 << 18;
+                        ThreadSafeQueue<int> queue;
+                        std::vector<std::thread> threads;
+
+                        timer.start();
+                        for (int i = 0; i < producers; ++i)
+                        {
+                            threads.emplace_back([&]()
+                                {
+                                    std::vector<int> items(batch);
+                                    for (size_t sent = 0; sent < count; sent += batch)
+                                        queue.PushRange(items.begin(), items.end());
+                                });
+                        }
+                        for (int i = 0; i < consumers; ++i)
+                        {
+                            threads.emplace_back([&]()
+                                {
+                                    std::vector<int> buffer(batch); // буфер выделяется один раз
+                                    for (size_t received = 0; received < producers * count / consumers;)
+                                        received += queue.PopBulk(buffer.begin(), std::min(batch, producers * count / consumers - received));
+                                });
+                        }
+                        for (auto& thread : threads)
+                        {
+                            thread.join();
+                        }
+                        timer.stop();
+                        std::cout << "batch = " << batch << ": " << producers * count / std::max(timer.elapsedSeconds(), 0.001) << " сообщений/сек" << std::endl;
+                    }
+
+                    // Статистика: глубина, задержка Push -> Pop, ожидание на пустой очереди, конкуренция за mutex
+                    {
+                        ThreadSafeQueue<int> plainQueue;
+                        ThreadSafeQueue<int, QueueStatistics> queue;
+                        std::cout << "без статистики: " << Throughput(plainQueue, 4, 4, 100000) << " сообщений/сек" << std::endl;
+                        std::cout << "со статистикой: " << Throughput(queue, 4, 4, 100000) << " сообщений/сек" << std::endl;
+                        
+                        const auto report = queue.Statistics().Snapshot();
+                        std::cout << "push = " << report.pushes << ", pop = " << report.pops << ", max depth = " << report.maxDepth << ", blocked pop = " << report.blockedPops << ", contended = " << report.contended << std::endl;
+                        for (size_t i = 0; i < report.latency.size(); ++i)
+                        {
+                            if (report.latency[i])
+                                std::cout << "latency < " << (uint64_t(1) << i) << " нс: " << report.latency[i] << std::endl;
+                        }
+                    }
+
                     std::cout << std::endl;
                 }
                 // shared_mutex
@@ -532,6 +724,377 @@ int main()
                         messages.Pop();
                     }
                     
+                    std::cout << std::endl;
+                }
+                // lock-free
+                {
+                    using namespace LOCK_FREE;
+                    std::cout << "lock-free" << std::endl;
+                    
+                    ThreadSafeQueue<std::string> messages(4);
+                    messages.Push("1");
+                    messages.Push("2");
+                    messages.Push("3");
+                    
+                    while (!messages.Empty())
+                    {
+                        auto result = messages.Pop();
+                    }
+                    
+                    // 16 писателей + 16 читателей: mutex vs lock-free
+                    {
+                        MUTEX::ThreadSafeQueue<int> mutexQueue;
+                        LOCK_FREE::ThreadSafeQueue<int> lockFreeQueue(1024);
+                        std::cout << "mutex: " << Throughput(mutexQueue, 16, 16, 100000) << " сообщений/сек" << std::endl;
+                        std::cout << "lock-free: " << Throughput(lockFreeQueue, 16, 16, 100000) << " сообщений/сек" << std::endl;
+                    }
+
+                    std::cout << std::endl;
+                }
+                // spsc - 1 писатель + 1 читатель
+                {
+                    using namespace SPSC;
+                    std::cout << "spsc" << std::endl;
+
+                    ThreadSafeQueue<std::string> messages(4);
+                    messages.Push("1");
+                    messages.Push("2");
+                    messages.Push("3");
+
+                    while (!messages.Empty())
+                    {
+                        auto result = messages.Pop();
+                    }
+
+                    // 1 писатель + 1 читатель: mutex vs spsc
+                    {
+                        MUTEX::ThreadSafeQueue<int> mutexQueue;
+                        SPSC::ThreadSafeQueue<int> spscQueue(1024);
+                        std::cout << "mutex: " << Throughput(mutexQueue, 1, 1, 1000000) << " сообщений/сек" << std::endl;
+                        std::cout << "spsc: " << Throughput(spscQueue, 1, 1, 10000000) << " сообщений/сек" << std::endl;
+                    }
+
+                    std::cout << std::endl;
+                }
+                // two-lock - писатели и читатели блокируют разные концы очереди
+                {
+                    using namespace TWO_LOCK;
+                    std::cout << "two-lock" << std::endl;
+
+                    ThreadSafeQueue<std::string> messages;
+                    messages.Push("1");
+                    messages.Push("2");
+                    messages.Push("3");
+
+                    while (!messages.Empty())
+                    {
+                        auto result = messages.Pop();
+                    }
+
+                    // 8 писателей + 8 читателей: mutex vs two-lock
+                    {
+                        MUTEX::ThreadSafeQueue<int> mutexQueue;
+                        TWO_LOCK::ThreadSafeQueue<int> twoLockQueue;
+                        std::cout << "mutex: " << Throughput(mutexQueue, 8, 8, 100000) << " сообщений/сек" << std::endl;
+                        std::cout << "two-lock: " << Throughput(twoLockQueue, 8, 8, 100000) << " сообщений/сек" << std::endl;
+                    }
+
+                    std::cout << std::endl;
+                }
+                // pool - без выделения памяти после прогрева
+                {
+                    using namespace POOL;
+                    std::cout << "pool" << std::endl;
+
+                    ThreadSafeQueue<std::unique_ptr<std::string>> messages(4); // move-only тип
+                    messages.Push(std::make_unique<std::string>("1"));
+                    messages.Push(std::make_unique<std::string>("2"));
+                    messages.Push(std::make_unique<std::string>("3"));
+
+                    while (!messages.Empty())
+                    {
+                        auto result = messages.Pop();
+                    }
+
+#if COUNT_ALLOCATIONS
+                    // Кол-во выделений памяти: сообщения (длинные std::string) по кругу проходят через очередь
+                    auto Allocations = [](auto& queue)
+                    {
+                        constexpr int size = 1000, count = 1000000;
+                        for (int i = 0; i < size; ++i) // прогрев
+                            queue.Push(std::string(100, 'x'));
+
+                        const size_t before = allocations.load();
+                        std::string message;
+                        for (int i = 0; i < count; ++i)
+                        {
+                            queue.TryPop(message);
+                            queue.Push(std::move(message));
+                        }
+
+                        return allocations.load() - before;
+                    };
+
+                    MUTEX::ThreadSafeQueue<std::string> mutexQueue;
+                    POOL::ThreadSafeQueue<std::string> poolQueue(1000);
+                    std::cout << "mutex: " << Allocations(mutexQueue) << " выделений памяти" << std::endl;
+                    std::cout << "pool: " << Allocations(poolQueue) << " выделений памяти" << std::endl;
+#else
+                    std::cout << "Подсчет выделений памяти выключен (COUNT_ALLOCATIONS = 0)" << std::endl;
+#endif
+
+                    std::cout << std::endl;
+                }
+                // futex - ожидание на std::atomic::wait вместо condition_variable
+                {
+                    using namespace FUTEX;
+                    std::cout << "futex" << std::endl;
+
+                    ThreadSafeQueue<std::string> messages;
+                    messages.Push("1");
+                    messages.Push("2");
+                    messages.Push("3");
+
+                    while (!messages.Empty())
+                    {
+                        auto result = messages.Pop();
+                    }
+
+                    // 4 писателя + 4 читателя: condition_variable vs futex
+                    {
+                        MUTEX::ThreadSafeQueue<int> mutexQueue;
+                        FUTEX::ThreadSafeQueue<int> futexQueue;
+                        std::cout << "condition_variable: " << Throughput(mutexQueue, 4, 4, 250000) << " сообщений/сек" << std::endl;
+                        std::cout << "futex: " << Throughput(futexQueue, 4, 4, 250000) << " сообщений/сек" << std::endl;
+                    }
+
+                    std::cout << std::endl;
+                }
+                // sharded - по подочереди на каждый аппаратный поток + work stealing
+                {
+                    using namespace SHARDED;
+                    std::cout << "sharded" << std::endl;
+
+                    ThreadSafeQueue<std::string> messages;
+                    messages.Push("1");
+                    messages.Push("2");
+                    messages.Push("3");
+
+                    std::string result;
+                    while (messages.TryPop(result))
+                    {
+                    }
+
+                    // Масштабирование: n писателей + n читателей, n до кол-ва аппаратных потоков
+                    for (int threads = 1; threads <= (int)std::max(std::thread::hardware_concurrency(), 1u); threads *= 2)
+                    {
+                        MUTEX::ThreadSafeQueue<int> mutexQueue;
+                        SHARDED::ThreadSafeQueue<int> shardedQueue;
+                        std::cout << "threads = " << threads
+                                  << ", mutex: " << Throughput(mutexQueue, threads, threads, 1000000 / threads) << " сообщений/сек"
+                                  << ", sharded: " << Throughput(shardedQueue, threads, threads, 1000000 / threads) << " сообщений/сек" << std::endl;
+                    }
+
+                    std::cout << std::endl;
+                }
+                // priority - срочные сообщения обгоняют обычные
+                {
+                    using namespace PRIORITY;
+                    std::cout << "priority" << std::endl;
+
+                    ThreadSafeQueue<std::string> messages;
+                    messages.Push(0, "обычное 1");
+                    messages.Push(0, "обычное 2");
+                    messages.Push(10, "срочное");
+
+                    std::cout << messages.Pop() << std::endl; // скорее всего срочное: порядок ослабленный (relaxed)
+
+                    // 4 потока: каждый добавляет элемент со случайным приоритетом и извлекает элемент
+                    auto Benchmark = [](auto&& Push, auto&& Pop)
+                    {
+                        constexpr int threads = 4, count = 250000;
+                        Timer timer;
+                        std::vector<std::thread> workers;
+
+                        timer.start();
+                        for (int i = 0; i < threads; ++i)
+                        {
+                            workers.emplace_back([&, i]()
+                                {
+                                    std::minstd_rand random(i + 1);
+                                    for (int j = 0; j < count; ++j)
+                                    {
+                                        Push(int(random() % 1000), j);
+                                        Pop();
+                                    }
+                                });
+                        }
+                        for (auto& worker : workers)
+                        {
+                            worker.join();
+                        }
+                        timer.stop();
+
+                        return threads * count / std::max(timer.elapsedSeconds(), 0.001);
+                    };
+
+                    // 1 mutex вокруг std::priority_queue
+                    {
+                        std::mutex mutex;
+                        std::priority_queue<std::pair<int, int>> queue;
+                        std::cout << "mutex + std::priority_queue: " << Benchmark([&](int priority, int value)
+                            {
+                                std::lock_guard lock(mutex);
+                                queue.emplace(priority, value);
+                            },
+                            [&]()
+                            {
+                                for (;;)
+                                {
+                                    std::lock_guard lock(mutex);
+                                    if (!queue.empty())
+                                        return queue.pop();
+                                }
+                            }) << " сообщений/сек" << std::endl;
+                    }
+                    // relaxed MultiQueue
+                    {
+                        ThreadSafeQueue<int> queue;
+                        std::cout << "PRIORITY::ThreadSafeQueue: " << Benchmark([&](int priority, int value) { queue.Push(priority, std::move(value)); },
+                                                                                [&]() { queue.Pop(); }) << " сообщений/сек" << std::endl;
+                    }
+#if defined(_MSC_VER) || defined(_MSC_FULL_VER) || defined(_WIN32) || defined(_WIN64)
+                    // tbb::concurrent_priority_queue
+                    {
+                        tbb::concurrent_priority_queue<std::pair<int, int>> queue;
+                        std::cout << "tbb::concurrent_priority_queue: " << Benchmark([&](int priority, int value) { queue.emplace(priority, value); },
+                                                                                     [&]()
+                                                                                     {
+                                                                                         std::pair<int, int> item;
+                                                                                         while (!queue.try_pop(item));
+                                                                                     }) << " сообщений/сек" << std::endl;
+                    }
+#endif
+
+                    std::cout << std::endl;
+                }
+                // hazard pointer - lock-free очередь без ограничения размера, память ограничена даже при остановившемся читателе
+                {
+                    using namespace HAZARD_POINTER;
+                    std::cout << "hazard pointer" << std::endl;
+                    
+                    ThreadSafeQueue<std::string> messages;
+                    messages.Push("1");
+                    messages.Push("2");
+                    messages.Push("3");
+                    
+                    while (!messages.Empty())
+                    {
+                        auto result = messages.Pop();
+                    }
+                    
+                    ThreadSafeStack<std::string> stack;
+                    stack.Push("1");
+                    stack.Push("2");
+                    while (!stack.Empty())
+                    {
+                        auto result = stack.Pop();
+                    }
+                    
+                    {
+                        MUTEX::ThreadSafeQueue<int> mutexQueue;
+                        ThreadSafeQueue<int> hazardQueue;
+                        std::cout << "mutex: " << Throughput(mutexQueue, 4, 4, 100000) << " сообщений/сек" << std::endl;
+                        std::cout << "hazard pointer: " << Throughput(hazardQueue, 4, 4, 100000) << " сообщений/сек" << std::endl;
+                    }
+                    
+                    /*
+                     Остановившийся читатель: один поток защитил узел (hazard pointer/EpochGuard) и остановился, остальные потоки продолжают удалять узлы.
+                     - hazard pointer: не освобождаются только защищенный узел и узлы до порога Scan - память ограничена.
+                     - EBR: эпоха не продвигается, поэтому не освобождается ни один узел - память растет.
+                     */
+                    {
+                        constexpr int count = 200000;
+                        std::atomic<bool> stalled = false, resume = false;
+                        
+                        // Защищенный узел не должен быть освобожден: читатель проверяет его значение после остановки (проверка не зависит от NDEBUG)
+                        std::atomic<int*> shared = new int(-1);
+                        int protectedValue = 0;
+                        std::thread reader([&]()
+                            {
+                                HP::HazardPointer hazard;
+                                const int* node = hazard.Protect(shared);
+                                stalled = true;
+                                while (!resume)
+                                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                                protectedValue = *node;
+                            });
+                        while (!stalled)
+                            std::this_thread::yield();
+                        std::thread writer([&]()
+                            {
+                                for (int i = 0; i < count; ++i)
+                                    HP::Retire(shared.exchange(new int(i)));
+                            });
+                        writer.join();
+                        std::cout << "hazard pointer, остановившийся читатель: удалено узлов: " << count << ", не освобождено: " << HP::Domain::Instance().Pending() << std::endl;
+                        resume = true;
+                        reader.join();
+                        std::cout << "hazard pointer, защищенный узел: " << protectedValue << " (ожидается -1)" << std::endl;
+                        HP::Retire(shared.exchange(new int(-1)));
+                        
+                        stalled = false, resume = false;
+                        std::thread epochReader([&]()
+                            {
+                                EBR::EpochGuard guard;
+                                const int* node = shared.load();
+                                stalled = true;
+                                while (!resume)
+                                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                                protectedValue = *node;
+                            });
+                        while (!stalled)
+                            std::this_thread::yield();
+                        std::thread epochWriter([&]()
+                            {
+                                for (int i = 0; i < count; ++i)
+                                    EBR::Retire(shared.exchange(new int(i)));
+                            });
+                        epochWriter.join();
+                        std::cout << "EBR, остановившийся читатель: удалено узлов: " << count << ", не освобождено: " << EBR::Domain::Instance().Pending() << std::endl;
+                        resume = true;
+                        epochReader.join();
+                        std::cout << "EBR, защищенный узел: " << protectedValue << " (ожидается -1)" << std::endl;
+                        delete shared.load();
+                        EBR::Synchronize();
+                    }
+                    
+                    std::cout << std::endl;
+                }
+                // Стек: ABA-безопасный стек с меткой (tagged pointer) и стек с исключением (elimination-backoff) при симметричной нагрузке Push + Pop
+                {
+                    std::cout << "stack" << std::endl;
+                    
+                    TAGGED::ThreadSafeStack<std::string> tagged;
+                    tagged.Push("1");
+                    tagged.Push("2");
+                    while (auto result = tagged.Pop())
+                        std::cout << *result << " ";
+                    std::cout << "(lock-free: " << std::boolalpha << TAGGED::ThreadSafeStack<std::string>::IS_LOCK_FREE << ")" << std::endl;
+                    
+                    for (int threads : { 1, 4, 16 })
+                    {
+                        MUTEX::ThreadSafeStack<int> mutexStack;
+                        TAGGED::ThreadSafeStack<int> taggedStack;
+                        HAZARD_POINTER::ThreadSafeStack<int> hazardStack;
+                        ELIMINATION::ThreadSafeStack<int> eliminationStack;
+                        std::cout << "потоков: " << threads << std::endl;
+                        std::cout << "mutex: " << StackThroughput(mutexStack, threads, 100000) << " операций/сек" << std::endl;
+                        std::cout << "tagged: " << StackThroughput(taggedStack, threads, 100000) << " операций/сек" << std::endl;
+                        std::cout << "hazard pointer: " << StackThroughput(hazardStack, threads, 100000) << " операций/сек" << std::endl;
+                        std::cout << "elimination: " << StackThroughput(eliminationStack, threads, 100000) << " операций/сек" << std::endl;
+                    }
+                    
                     std::cout << std::endl;
                 }
             }
@@ -1,42 +1,311 @@
 #pragma once
 
+#include "SharedMutex.h"
+
+#include <algorithm>
 #include <atomic>
+#include <cassert>
 #include <shared_mutex>
+#include <system_error>
 #include <thread>
+#include <vector>
 
 
-class shared_recursive_mutex : public std::shared_mutex
+/*
+ Полностью рекурсивная блокировка чтения/записи с повышением (upgrade) чтения до записи поверх TSharedMutex:
+ - std::shared_mutex - один общий счетчик читателей.
+ - BIG_READER::shared_mutex - счетчики читателей по потокам в разных кэш-линиях, чтение не пишет в общую кэш-линию (SharedMutex.h).
+ Рекурсия:
+ - запись - владелец (_owner) и счетчик (_exclusive) хранятся в мьютексе, как у рекурсивного мьютекса, повторный lock - только счетчик.
+ - чтение - у каждого потока свои счетчики чтения для каждого мьютекса (thread_local), поэтому TSharedMutex захватывается только при первом захвате потоком.
+ Поток, владеющий записью, может захватывать чтение (lock_shared) без обращения к TSharedMutex.
+ Повышение чтения до записи без освобождения блокировки:
+ - _upgrader - поток с правом повышения, право одно на мьютекс. Его берут только lock_upgrade и try_upgrade, обычные писатели не обращаются к нему.
+   Владелец права всегда держит чтение или запись, а поток, ожидающий право, не держит чтение (иначе он и повышающийся поток ждали бы друг друга).
+ - переход (повышение: unlock_shared + lock, понижение: unlock + lock_shared) отмечается счетчиком _transitions (понижение писателя может совпасть с повышением владельца права). Писатель, захвативший TSharedMutex во время перехода, освобождает его и ждет конца перехода, поэтому данные, прочитанные до повышения, не изменятся. Между unlock_shared и lock может войти только читатель.
+ Способы повышения:
+ - lock_upgrade + lock (или upgrade) - гарантированное повышение, право повышения берется заранее, одновременно с чтением.
+ - lock_shared + try_upgrade - повышение обычного читателя, если право повышения свободно, иначе false (нужно освободить чтение и захватить запись заново).
+ Замечание: lock при захваченном обычном чтении (без права повышения) привел бы к взаимной блокировке: два читателя ждут друг друга, чтобы повыситься. Поэтому в этом случае исключение std::system_error (resource_deadlock_would_occur), как у std::mutex при повторном захвате.
+ */
+template <class TSharedMutex>
+class basic_shared_recursive_mutex
 {
+    basic_shared_recursive_mutex(const basic_shared_recursive_mutex&) = delete;
+    basic_shared_recursive_mutex& operator=(const basic_shared_recursive_mutex&) = delete;
+
+    // Захваты чтения мьютекса текущим потоком
+    struct Ownership
+    {
+        const void* mutex;
+        int shared = 0;
+        int upgradable = 0;
+    };
+
 public:
-    void lock() 
+    basic_shared_recursive_mutex() = default;
+
+    void lock()
     {
-        std::thread::id this_id = std::this_thread::get_id();
-        if (_owner == this_id) // Рекурсивная блокировка
+        if (Owner()) // Рекурсивная блокировка
         {
-            ++_count;
+            ++_exclusive;
+            return;
         }
+
+        // Поток без захватов чтения - пустой thread_local вектор, поиска нет
+        Ownership* ownership = Find();
+        if (ownership && ownership->upgradable > 0) // Повышение: право повышения уже у потока
+            Transition(*ownership);
+        else if (ownership && ownership->shared > 0)
+            throw std::system_error(std::make_error_code(std::errc::resource_deadlock_would_occur), "shared_recursive_mutex: повышение чтения до записи без права повышения, используйте lock_upgrade или try_upgrade");
         else // Обычная блокировка
+            Lock();
+        SetOwner();
+    }
+
+    bool try_lock()
+    {
+        if (Owner())
+        {
+            ++_exclusive;
+            return true;
+        }
+        // Повышение - только через upgrade/try_upgrade
+        if (Ownership* ownership = Find(); ownership && ownership->shared > 0)
+            return false;
+
+        if (!_mutex.try_lock())
+            return false;
+        if (_transitions.load(std::memory_order_seq_cst) > 0) // Идет повышение/понижение другого потока
+        {
+            _mutex.unlock();
+            return false;
+        }
+        SetOwner();
+        return true;
+    }
+
+    void unlock()
+    {
+        assert(Owner() && "shared_recursive_mutex: unlock без lock");
+        if (--_exclusive > 0) // Рекурсивная разблокировка
+            return;
+
+        _owner.store(std::thread::id(), std::memory_order_relaxed);
+        Ownership* ownership = Find();
+        if (ownership && ownership->shared > 0) // Понижение до чтения: писатели не вклинятся
+        {
+            _transitions.fetch_add(1, std::memory_order_seq_cst);
+            _mutex.unlock();
+            _mutex.lock_shared();
+            EndTransition();
+        }
+        else
+        {
+            _mutex.unlock();
+        }
+
+        if (Upgrader() && (!ownership || ownership->upgradable == 0)) // Право повышения взято через try_upgrade
+            ReleaseUpgrade();
+        if (ownership)
+            Release(*ownership);
+    }
+
+    void lock_shared()
+    {
+        Ownership& ownership = Local();
+        if (ownership.shared++ == 0 && !Owner())
+            _mutex.lock_shared();
+    }
+
+    bool try_lock_shared()
+    {
+        Ownership& ownership = Local();
+        if (ownership.shared == 0 && !Owner() && !_mutex.try_lock_shared())
         {
-            shared_mutex::lock();
-            _owner = this_id;
-            _count = 1;
+            Release(ownership);
+            return false;
         }
+        ++ownership.shared;
+        return true;
     }
-    void unlock() 
+
+    void unlock_shared()
+    {
+        Ownership& ownership = Local();
+        assert(ownership.shared > 0 && "shared_recursive_mutex: unlock_shared без lock_shared");
+        if (--ownership.shared == 0 && !Owner())
+            _mutex.unlock_shared();
+        Release(ownership);
+    }
+
+    // Чтение с правом повышения до записи: право одно на мьютекс, обычные читатели не ждут
+    void lock_upgrade()
     {
-        if (_count > 1) // Рекурсивная разблокировка
+        Ownership& ownership = Local();
+        if (Upgrader() || Owner()) // Владелец записи получает право сразу: владелец права держит чтение, поэтому другого владельца нет
         {
-            --_count;
+            if (!Upgrader())
+                _upgrader.store(std::this_thread::get_id(), std::memory_order_relaxed);
+            ++ownership.upgradable;
+            lock_shared();
+            return;
         }
-        else  // Обычная разблокировка
+        if (ownership.shared > 0)
         {
-            _owner = std::thread::id();
-            _count = 0;
-            shared_mutex::unlock();
+            Release(ownership);
+            throw std::system_error(std::make_error_code(std::errc::resource_deadlock_would_occur), "shared_recursive_mutex: lock_upgrade при захваченном чтении, используйте try_upgrade");
         }
+
+        while (true)
+        {
+            lock_shared();
+            std::thread::id none;
+            if (_upgrader.compare_exchange_strong(none, std::this_thread::get_id(), std::memory_order_acquire, std::memory_order_relaxed))
+                break;
+
+            // Право у другого потока - ждем без чтения, чтобы не мешать его повышению
+            unlock_shared();
+            _upgrader.wait(none, std::memory_order_relaxed);
+        }
+        ++Local().upgradable;
+    }
+
+    void unlock_upgrade()
+    {
+        Ownership& ownership = Local();
+        assert(ownership.upgradable > 0 && "shared_recursive_mutex: unlock_upgrade без lock_upgrade");
+        if (--ownership.upgradable == 0 && !Owner())
+            ReleaseUpgrade();
+        unlock_shared();
+    }
+
+    // Повышение права повышения до записи, освобождение - unlock (или downgrade)
+    void upgrade()
+    {
+        assert(Find() && Find()->upgradable > 0 && "shared_recursive_mutex: upgrade без lock_upgrade");
+        lock();
+    }
+
+    // Повышение обычного чтения до записи: false - право повышения у другого потока
+    bool try_upgrade()
+    {
+        Ownership& ownership = Local();
+        assert(ownership.shared > 0 && "shared_recursive_mutex: try_upgrade без lock_shared");
+        if (Owner() || ownership.upgradable > 0)
+        {
+            lock();
+            return true;
+        }
+        std::thread::id none;
+        if (!_upgrader.compare_exchange_strong(none, std::this_thread::get_id(), std::memory_order_acquire, std::memory_order_relaxed))
+            return false;
+
+        // Право повышения держится до unlock: иначе другой читатель начнет повышение и запишет раньше
+        Transition(ownership);
+        SetOwner();
+        return true;
+    }
+
+    // Понижение записи до чтения
+    void downgrade()
+    {
+        unlock();
     }
 
 private:
+    bool Owner() const noexcept
+    {
+        return _owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+
+    bool Upgrader() const noexcept
+    {
+        return _upgrader.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+
+    void ReleaseUpgrade() noexcept
+    {
+        _upgrader.store(std::thread::id(), std::memory_order_release);
+        _upgrader.notify_all();
+    }
+
+    void SetOwner() noexcept
+    {
+        _owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        _exclusive = 1;
+    }
+
+    // Обычная запись: во время перехода другого потока запись уступается ему
+    void Lock()
+    {
+        _mutex.lock();
+        while (int transitions = _transitions.load(std::memory_order_seq_cst))
+        {
+            _mutex.unlock();
+            _transitions.wait(transitions, std::memory_order_relaxed);
+            _mutex.lock();
+        }
+    }
+
+    // Повышение: у потока право повышения, поэтому повышение одно
+    void Transition([[maybe_unused]] const Ownership& ownership)
+    {
+        assert(ownership.shared > 0);
+        // seq_cst: переход виден писателю, который захватит TSharedMutex после unlock_shared
+        _transitions.fetch_add(1, std::memory_order_seq_cst);
+        _mutex.unlock_shared();
+        _mutex.lock();
+        EndTransition();
+    }
+
+    void EndTransition() noexcept
+    {
+        _transitions.fetch_sub(1, std::memory_order_release);
+        _transitions.notify_all();
+    }
+
+    Ownership* Find()
+    {
+        std::vector<Ownership>& owned = Owned();
+        auto it = std::find_if(owned.begin(), owned.end(), [this](const Ownership& ownership) { return ownership.mutex == this; });
+        return it != owned.end() ? &*it : nullptr;
+    }
+
+    Ownership& Local()
+    {
+        if (Ownership* ownership = Find())
+            return *ownership;
+
+        return Owned().emplace_back(Ownership{ this });
+    }
+
+    // Мьютекс больше не захвачен потоком для чтения - запись удаляется
+    static void Release(Ownership& ownership)
+    {
+        if (ownership.shared > 0 || ownership.upgradable > 0)
+            return;
+
+        std::vector<Ownership>& owned = Owned();
+        std::swap(ownership, owned.back());
+        owned.pop_back();
+    }
+
+    // Поток обычно держит несколько мьютексов, поэтому линейный поиск
+    static std::vector<Ownership>& Owned()
+    {
+        thread_local std::vector<Ownership> owned;
+        return owned;
+    }
+
+private:
+    TSharedMutex _mutex;
+    std::atomic<std::thread::id> _upgrader; // поток с правом повышения
+    std::atomic<int> _transitions = 0; // повышения/понижения в процессе
     std::atomic<std::thread::id> _owner;
-    int _count;
+    int _exclusive = 0; // изменяется только владельцем записи
 };
+
+using shared_recursive_mutex = basic_shared_recursive_mutex<std::shared_mutex>;
+using big_reader_shared_recursive_mutex = basic_shared_recursive_mutex<BIG_READER::shared_mutex>;